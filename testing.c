@@ -1,10 +1,98 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
 #include "universal.h"
 #include "utility.h"
+#include "utility/crc32.h"
 #include "types/types.h"
 
+static unsigned long int allocator_calls[3]; /* allocate, reallocate and release */
+
+static void *counting_allocate(void *user, unsigned long int size)
+{
+	((unsigned long int *)user)[0]++;
+	return(malloc(size));
+}
+
+static void *counting_reallocate(void *user, void *ptr, unsigned long int size)
+{
+	((unsigned long int *)user)[1]++;
+	return(realloc(ptr, size));
+}
+
+static void counting_release(void *user, void *ptr)
+{
+	((unsigned long int *)user)[2]++;
+	free(ptr);
+}
+
+/*
+ * The allocator can only be set before anything is allocated, so these run in
+ * a process of their own under an allocator counting every call
+ */
+static void counting_checks(void)
+{
+	safe_string_allocator_t counting = { counting_allocate, counting_reallocate, counting_release, allocator_calls };
+	safe_string_allocator_t broken = { counting_allocate, SAFE_STRING_INVALID, counting_release, SAFE_STRING_INVALID };
+	unsigned long int calls[3], i;
+	s_string_t counted;
+
+	safe_string_set_allocator(&counting);
+
+	counted = safe_string_new("a string too long to be stored inline");
+	printf("allocator new: %lu %lu %lu\n", allocator_calls[0], allocator_calls[1], allocator_calls[2]);
+	memcpy(calls, allocator_calls, sizeof(calls));
+	safe_string_concatenate(counted, counted);
+	safe_string_concatenate(counted, counted);
+	safe_string_delete(counted);
+	printf("allocator grow and delete: %lu %lu %lu balanced? %s\n", allocator_calls[0] - calls[0], allocator_calls[1] - calls[1], allocator_calls[2] - calls[2], allocator_calls[0] == allocator_calls[2] ? "yes" : "no");
+
+	{
+		s_string_t cached[3];
+
+		safe_string_cache_set_limit(2);
+		memcpy(calls, allocator_calls, sizeof(calls));
+		for(i = 0; i < 3; i++) {
+			cached[i] = safe_string_new("a string too long to be stored inline");
+		}
+		for(i = 0; i < 3; i++) {
+			safe_string_delete(cached[i]);
+		}
+		printf("cache release: %lu allocated %lu freed\n", allocator_calls[0] - calls[0], allocator_calls[2] - calls[2]); /* two structures and buffers stay cached */
+
+		memcpy(calls, allocator_calls, sizeof(calls));
+		cached[0] = safe_string_new("a string too long to be stored inline");
+		cached[1] = safe_string_new("short");
+		printf("cache reuse: %lu allocated\n", allocator_calls[0] - calls[0]);
+		safe_string_delete(cached[0]);
+		safe_string_delete(cached[1]);
+
+		memcpy(calls, allocator_calls, sizeof(calls));
+		safe_string_cache_set_limit(1);
+		printf("cache limit lowered: %lu freed\n", allocator_calls[2] - calls[2]);
+		memcpy(calls, allocator_calls, sizeof(calls));
+		safe_string_cache_flush();
+		printf("cache flush: %lu freed balanced? %s\n", allocator_calls[2] - calls[2], allocator_calls[0] == allocator_calls[2] ? "yes" : "no");
+
+		safe_string_cache_set_limit(0);
+	}
+
+	safe_string_set_allocator(&broken);
+	printf("allocator missing callback: %d kept? %s\n", safe_string_error_val(), safe_string_get_allocator().allocate == counting_allocate && safe_string_get_allocator().user == allocator_calls ? "yes" : "no");
+}
+
 int main(int argc, char **argv)
 {
+	fflush(stdout);
+	if(!fork()) {
+		counting_checks();
+		fflush(stdout);
+		_exit(0);
+	}
+	wait(NULL);
+
 	unsigned long int i = 0, j = 0, count = 0;
         char *freqs;
 	s_string_t str = safe_string_new("z%%^ZHello, \x083world!ZZzz%^");
@@ -115,6 +203,705 @@ int main(int argc, char **argv)
 		printf("%c\n", freqs[i]);
 	}
 
+	{
+		long int page = sysconf(_SC_PAGESIZE);
+		char path[] = "/tmp/safe_string_XXXXXX", *contents = (char *)malloc(page);
+		s_string_t mapped, bang = safe_string_new("!");
+		int fd = mkstemp(path);
+
+		memset(contents, 'm', page);
+		if(write(fd, contents, page) != page) {
+			printf("write failed\n");
+		}
+		close(fd);
+
+		mapped = safe_string_map_file(path); /* fills it's last page, the terminator comes from the zeroed page after it */
+		printf("mapped page: %s %s\n", safe_string_length(mapped) == (unsigned long int)page ? "whole" : "short", mapped->s_string[page] == '\0' && !strncmp(mapped->s_string, contents, page) ? "terminated" : "unterminated");
+
+		safe_string_concatenate(mapped, bang);
+		printf("mapped copy: %s %c %s\n", safe_string_length(mapped) == (unsigned long int)page + 1 ? "whole" : "short", safe_string_index(mapped, page), mapped->s_flags & _S_STRING_FLAG_MAPPED ? "mapped" : "heap");
+		safe_string_delete(mapped);
+
+		if(truncate(path, 0)) {
+			printf("truncate failed\n");
+		}
+
+		mapped = safe_string_map_file(path);
+		printf("mapped empty: %lu error? %s\n", safe_string_length(mapped), safe_string_error() ? "yes" : "no");
+		safe_string_delete(mapped);
+
+		unlink(path);
+		free(contents);
+		safe_string_delete(bang);
+	}
+
+	{
+		s_string_t large = safe_string_new("0123456789abcdef");
+
+		while(safe_string_length(large) <= 1UL << 21) { /* crosses the 1 MiB mapping threshold, then grows the mapping */
+			safe_string_concatenate(large, large);
+		}
+
+		printf("large: %lu %s %s\n", safe_string_length(large), large->s_flags & _S_STRING_FLAG_LARGE ? "mapped" : "heap", !strncmp(large->s_string + safe_string_length(large) - 16, "0123456789abcdef", 16) ? "intact" : "corrupt");
+		safe_string_delete(large);
+		printf("large deleted error? %s\n", safe_string_error() ? "yes" : "no");
+	}
+
+	{
+		char *text = (char *)malloc(1025);
+		s_string_t flat, needle, flattened;
+		safe_string_rope_t rope, empty;
+		s_string_rope_iterator_t iterator;
+		s_string_view_t chunk;
+		unsigned long int chunks = 0;
+
+		memset(text, 'x', 1024);
+		text[1024] = '\0';
+		memcpy(text + 508, "abcabcabd", 9); /* straddles the boundary between the two chunks at 512 */
+
+		flat = safe_string_new(text);
+		rope = safe_string_rope_new(flat);
+
+		safe_string_rope_iterator(rope, &iterator);
+		while(safe_string_rope_iterator_next(&iterator, &chunk)) {
+			chunks++;
+		}
+		printf("rope chunks: %lu\n", chunks);
+
+		needle = safe_string_new("abcabd"); /* repeats it's prefix, so the search has to fall back within the match */
+		printf("rope locate: %lu string locate: %lu\n", safe_string_rope_locate(rope, needle), safe_string_string_locate(flat, needle));
+		safe_string_delete(needle);
+
+		needle = safe_string_new("xxabcabcabdxx");
+		printf("rope locate: %lu error? %s\n", safe_string_rope_locate(rope, needle), safe_string_error() ? "yes" : "no");
+		safe_string_delete(needle);
+
+		needle = safe_string_new("abcabcabcabd");
+		safe_string_rope_locate(rope, needle);
+		printf("rope locate missing: %d\n", safe_string_error_val());
+		safe_string_delete(needle);
+
+		printf("rope crc32 == string crc32 ? %s\n", safe_string_rope_crc32(rope) == safe_string_crc32(flat) ? "true" : "false");
+
+		empty = safe_string_rope_new(SAFE_STRING_INVALID);
+		safe_string_rope_iterator(empty, &iterator);
+		printf("empty rope chunks: %d\n", safe_string_rope_iterator_next(&iterator, &chunk));
+
+		needle = safe_string_new("x");
+		safe_string_rope_locate(empty, needle);
+		printf("empty rope locate: %d\n", safe_string_error_val());
+		safe_string_delete(needle);
+
+		flattened = safe_string_rope_string(empty);
+		printf("empty rope length: %lu %lu crc32: %u\n", safe_string_rope_length(empty), safe_string_length(flattened), safe_string_rope_crc32(empty));
+
+		safe_string_delete(flattened);
+		safe_string_rope_delete(empty);
+		safe_string_rope_delete(rope);
+		safe_string_delete(flat);
+		safe_string_crc32_delete();
+		free(text);
+	}
+
+	{
+		s_string_stats_t before, after;
+		s_string_t shared, sharers[3], other = safe_string_new("!");
+
+		safe_string_stats_thread(&before);
+		shared = safe_string_new("a string too long to be stored inline, so it's shared");
+		sharers[0] = safe_string_duplicate(shared);
+		sharers[1] = safe_string_duplicate(shared);
+		sharers[2] = safe_string_duplicate(shared);
+		printf("shared: %s references: %lu same buffer? %s\n", (sharers[0]->s_flags & _S_STRING_FLAG_SHARED) ? "yes" : "no", _safe_string_shared(shared)->s_references, (sharers[0]->s_string == shared->s_string) ? "yes" : "no");
+
+		safe_string_index_set(sharers[0], 0, 'A');
+		printf("index set: %s | %s references: %lu\n", sharers[0]->s_string, shared->s_string, _safe_string_shared(shared)->s_references);
+
+		safe_string_concatenate(sharers[1], other);
+		printf("concatenate: %s | %s references: %lu\n", sharers[1]->s_string, shared->s_string, _safe_string_shared(shared)->s_references);
+
+		safe_string_copy(sharers[2], other);
+		printf("copy: %s | %s references: %lu\n", sharers[2]->s_string, shared->s_string, _safe_string_shared(shared)->s_references);
+
+		safe_string_delete(sharers[0]);
+		safe_string_delete(sharers[1]);
+		safe_string_delete(sharers[2]);
+
+		sharers[0] = safe_string_duplicate(shared);
+		safe_string_delete(shared);
+		printf("last sharer: %s references: %lu\n", sharers[0]->s_string, _safe_string_shared(sharers[0])->s_references);
+		safe_string_delete(sharers[0]);
+
+		safe_string_stats_thread(&after);
+		printf("shared released: %s\n", (after.st_live_bytes == before.st_live_bytes && after.st_live_strings == before.st_live_strings) ? "yes" : "no");
+		safe_string_delete(other);
+	}
+
+	{
+		unsigned long int lengths[] = { 2, 15, 16, 17, 31, 32, 33, 40 }, n, start, end, boundary, outside, straddle;
+		char text[101], pattern[41];
+		s_string_t haystack, needle;
+
+		for(i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+			n = lengths[i];
+			memset(pattern, 'a', n - 1); /* every character of the haystack is a candidate for the first byte */
+			pattern[n - 1] = 'b';
+			pattern[n] = '\0';
+			needle = safe_string_new(pattern);
+
+			memset(text, 'a', 100);
+			text[100] = '\0';
+			text[n - 1] = 'b';
+			haystack = safe_string_new(text);
+			start = safe_string_string_locate(haystack, needle);
+			safe_string_delete(haystack);
+
+			text[n - 1] = 'a';
+			text[99] = 'b'; /* 101 - n is never a multiple of the vector width, so the scalar tail finds it */
+			haystack = safe_string_new(text);
+			end = safe_string_string_locate(haystack, needle);
+			boundary = safe_string_string_locate_offset_limit(haystack, needle, 100 - n, 100);
+			safe_string_string_locate_offset_limit(haystack, needle, 101 - n, 100);
+			outside = safe_string_error_val();
+			safe_string_string_locate_offset_limit(haystack, needle, 0, 99);
+			straddle = safe_string_error_val();
+			safe_string_delete(haystack);
+
+			printf("locate %lu: start %lu end %lu boundary %lu outside %lu straddle %lu\n", n, start, end, boundary, outside, straddle);
+			safe_string_delete(needle);
+		}
+
+		memset(text, 'a', 100);
+		text[99] = 'b';
+		haystack = safe_string_new(text);
+
+		needle = safe_string_new("b");
+		printf("locate 1: %lu", safe_string_string_locate(haystack, needle));
+		safe_string_string_locate_limit(haystack, needle, 99);
+		printf(" straddle %d\n", safe_string_error_val());
+		safe_string_delete(needle);
+
+		needle = safe_string_new("");
+		safe_string_string_locate(haystack, needle);
+		printf("locate empty: %d", safe_string_error_val());
+		safe_string_string_locate_view(safe_string_view(haystack), safe_string_view(needle));
+		printf(" view %d kernel %lu\n", safe_string_error_val(), _safe_string_range_find(text, 100, "", 0));
+		safe_string_delete(needle);
+
+		safe_string_delete(haystack);
+	}
+
+	{
+		safe_string_arena_t arena = safe_string_arena_new(256);
+		s_string_t scoped = safe_string_new_in(arena, "request scoped"), oversized;
+		struct _s_string_arena_block_t *first;
+		char big[1025];
+
+		safe_string_concatenate(scoped, scoped);
+		printf("arena: %s %s\n", scoped->s_string, (scoped->s_flags & _S_STRING_FLAG_ARENA) ? "arena" : "heap");
+		safe_string_delete(scoped); /* a no-op, the arena owns it */
+		printf("arena delete: %s\n", scoped->s_string);
+
+		memset(big, 'o', 1024);
+		big[1024] = '\0';
+		oversized = safe_string_new_in(arena, big);
+		first = arena->blocks;
+		printf("arena oversized: %lu current block in front? %s\n", safe_string_length(oversized), first->size == 256 ? "yes" : "no");
+
+		safe_string_arena_reset(arena);
+		printf("arena reset: %s %lu %lu %s\n", arena->blocks == first ? "kept" : "replaced", arena->blocks->size, arena->blocks->used, arena->blocks->next ? "more" : "single");
+
+		scoped = safe_string_new_in(arena, "reused");
+		printf("arena reuse: %s %s\n", scoped->s_string, (char *)scoped >= first->data && (char *)scoped < first->data + first->size ? "same block" : "new block");
+
+		safe_string_arena_delete(arena);
+		printf("arena deleted error? %s\n", safe_string_error() ? "yes" : "no");
+		safe_string_arena_reset(SAFE_STRING_INVALID);
+		printf("arena reset null: %d\n", safe_string_error_val());
+	}
+
+	{
+		s_string_t csv = safe_string_new("alpha,,beta,gamma,"), comma = safe_string_new(","), none = safe_string_new(""), piece;
+		s_strings_packed_t packed = safe_string_split_packed(csv, comma);
+		s_strings_t split;
+		safe_strings_vec_t vec;
+		unsigned long int length = 0, pieces = 0;
+
+		printf("packed: %lu", safe_strings_packed_count(packed));
+		for(i = 0; i < safe_strings_packed_count(packed); i++) {
+			printf(" [%s]", safe_strings_packed_index(packed, i, &length));
+		}
+		printf(" last length %lu\n", length);
+
+		safe_strings_packed_index(packed, 5, &length);
+		printf("packed index bounds: %d\n", safe_string_error_val());
+
+		piece = safe_strings_packed_string(packed, 2);
+		safe_strings_packed_delete(packed);
+		printf("packed string: %s %lu\n", piece->s_string, safe_string_length(piece)); /* a copy, outliving the array */
+		safe_string_delete(piece);
+
+		packed = safe_string_chunk_split_packed(csv, 5, "|");
+		printf("packed chunks: %lu %s\n", safe_strings_packed_count(packed), safe_strings_packed_index(packed, 3, SAFE_STRING_INVALID));
+		safe_strings_packed_delete(packed);
+
+		split = safe_string_split(csv, none, &pieces);
+		printf("split empty delimeter: %d %lu %s", safe_string_error_val(), pieces, split ? "array" : "invalid");
+		packed = safe_string_split_packed(csv, none);
+		printf(" packed %d %s", safe_string_error_val(), packed ? "array" : "invalid");
+		vec = safe_string_split_vec(csv, none);
+		printf(" vec %d %s", safe_string_error_val(), vec ? "vec" : "invalid");
+		piece = safe_string_replace(csv, none, comma);
+		printf(" replace %d %s\n", safe_string_error_val(), piece ? "string" : "invalid");
+
+		safe_string_delete(none);
+		safe_string_delete(comma);
+		safe_string_delete(csv);
+	}
+
+	{
+		const char *inputs[][2] = { { "a", "a" }, { "bbbaba", "ba" }, { "bbaba,a,bbbbbaab", "bb" }, { "key = value ", " = " } };
+		s_string_t line = safe_string_new("  key = value  "), piece, source, delim;
+		s_string_view_t view = safe_string_trim_view(safe_string_view(line)), slice, *views;
+		s_strings_t pieces;
+		s_strings_packed_t packed;
+		unsigned long int view_count = 0, piece_count = 0;
+		int agree;
+
+		slice = safe_string_view_slice(view, 6, 11);
+		printf("view: [%.*s] slice: [%.*s]", (int)view.v_length, view.v_string, (int)slice.v_length, slice.v_string);
+		slice = safe_string_view_slice(view, view.v_length, view.v_length);
+		printf(" end slice: %lu", slice.v_length);
+		slice = safe_string_view_slice(view, 6, 20); /* the limit is clamped to the view */
+		printf(" clamped slice: [%.*s]", (int)slice.v_length, slice.v_string);
+		slice = safe_string_view_slice(view, 12, 20);
+		printf(" bad slice: %d %s\n", safe_string_error_val(), safe_string_view_valid(slice) ? "valid" : "invalid");
+
+		piece = safe_string_view_string(safe_string_substring_view(line, 2, 5));
+		printf("view string: %s compare: %d\n", piece->s_string, safe_string_compare_view(safe_string_view(piece), safe_string_view_char("key")));
+		safe_string_delete(piece);
+
+		for(i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+			source = safe_string_new(inputs[i][0]);
+			delim = safe_string_new(inputs[i][1]);
+			views = safe_string_split_view(safe_string_view(source), safe_string_view(delim), &view_count);
+			pieces = safe_string_split(source, delim, &piece_count);
+			packed = safe_string_split_packed(source, delim);
+			agree = view_count == piece_count && piece_count == safe_strings_packed_count(packed);
+
+			printf("split \"%s\" on \"%s\":", inputs[i][0], inputs[i][1]);
+			for(j = 0; j < view_count; j++) {
+				printf(" [%.*s]", (int)views[j].v_length, views[j].v_string);
+				agree = agree && !safe_string_compare_view(views[j], safe_string_view(pieces[j])) && !strcmp(pieces[j]->s_string, safe_strings_packed_index(packed, j, SAFE_STRING_INVALID));
+			}
+			printf(" variants agree? %s\n", agree ? "yes" : "no");
+
+			safe_string_free(views);
+			safe_string_array_delete(pieces, piece_count);
+			safe_strings_packed_delete(packed);
+			safe_string_delete(delim);
+			safe_string_delete(source);
+		}
+
+		safe_string_delete(line);
+	}
+
+	{
+		safe_string_intern_t table = safe_string_intern_new();
+		s_string_t canonical, again, word;
+		uint32_t id = 0, again_id = 0;
+		char text[16];
+		int consecutive = 1;
+
+		for(i = 0; i < 100; i++) { /* enough to grow the table */
+			snprintf(text, sizeof(text), "word%lu", i);
+			safe_string_intern_view(table, safe_string_view_char(text), &id);
+			consecutive = consecutive && id == i;
+		}
+		printf("intern: %lu ids consecutive? %s\n", safe_string_intern_count(table), consecutive ? "yes" : "no");
+
+		word = safe_string_new("word42");
+		canonical = safe_string_intern(table, word, &id);
+		again = safe_string_intern_view(table, safe_string_view_char("word42"), &again_id);
+		printf("intern again: %u %u same string? %s copied? %s count %lu\n", id, again_id, canonical == again ? "yes" : "no", canonical == word ? "no" : "yes", safe_string_intern_count(table));
+		printf("intern lookup: %s", safe_string_intern_lookup(table, 7)->s_string);
+		safe_string_intern_lookup(table, 100);
+		printf(" missing %d\n", safe_string_error_val());
+
+		safe_string_index_set(canonical, 0, 'W');
+		printf("intern modify: %d", safe_string_error_val());
+		safe_string_delete(canonical);
+		printf(" delete kept: %s\n", safe_string_intern_lookup(table, 42)->s_string);
+
+		safe_string_delete(word);
+		safe_string_intern_delete(table);
+		printf("intern deleted error? %s\n", safe_string_error() ? "yes" : "no");
+	}
+
+	{
+		const char *names[] = { "one", "two", "three" };
+		s_string_stats_t before, stats;
+		s_string_t counted, part, copy, suffix;
+		s_strings_t parts, batch;
+		safe_string_arena_t arena;
+
+		safe_string_stats_reset();
+		safe_string_stats_thread(&before);
+		counted = safe_string_new("a counted string, long enough to be shared");
+		part = safe_string_substring(counted, 2, 9);
+		copy = safe_string_duplicate(counted);
+		suffix = safe_string_new("?");
+		safe_string_concatenate(copy, suffix); /* unshares the copy */
+		parts = safe_string_split_char(counted, ",", &count);
+		safe_string_stats_thread(&stats);
+		printf("stats calls: new %lu allocate %lu share %lu reallocate %lu array %lu live %ld copied %lu\n", stats.st_calls[SAFE_STRING_STATS_NEW], stats.st_calls[SAFE_STRING_STATS_ALLOCATE], stats.st_calls[SAFE_STRING_STATS_SHARE], stats.st_calls[SAFE_STRING_STATS_REALLOCATE], stats.st_calls[SAFE_STRING_STATS_ARRAY], stats.st_live_strings - before.st_live_strings, stats.st_bytes_copied);
+
+		safe_string_array_delete(parts, count);
+		safe_string_delete(suffix);
+		safe_string_delete(copy);
+		safe_string_delete(part);
+		safe_string_delete(counted);
+		safe_string_stats_thread(&stats);
+		printf("stats deleted: live %ld %ld peak above start? %s\n", stats.st_live_strings - before.st_live_strings, stats.st_live_bytes - before.st_live_bytes, stats.st_peak_live_bytes > before.st_live_bytes ? "yes" : "no");
+
+		safe_string_stats_reset();
+		arena = safe_string_arena_new(0);
+		safe_string_new_in(arena, "arena string");
+		batch = safe_string_new_batch(names, SAFE_STRING_INVALID, 3);
+		safe_string_stats_thread(&stats);
+		printf("stats arena: %lu calls %s, new %lu live %ld\n", stats.st_calls[SAFE_STRING_STATS_ARENA], stats.st_bytes_allocated >= 4096 ? "with the block" : "without the block", stats.st_calls[SAFE_STRING_STATS_NEW], stats.st_live_strings - before.st_live_strings);
+		safe_string_batch_delete(batch);
+		safe_string_arena_delete(arena);
+
+		safe_string_stats_thread(SAFE_STRING_INVALID);
+		printf("stats null: %d\n", safe_string_error_val());
+	}
+
+	{
+		char *buffer = (char *)_safe_string_malloc(64), *released;
+		s_string_t adopted, target = safe_string_new("target"), other = safe_string_new("a longer string held in it's own buffer");
+		unsigned long int length = 0;
+
+		memcpy(buffer, "adopted buffer", 14);
+		adopted = safe_string_adopt(buffer, 14, 64);
+		printf("adopt: %s %lu copied? %s\n", adopted->s_string, safe_string_length(adopted), adopted->s_string == buffer ? "no" : "yes");
+		safe_string_adopt(buffer, 64, 64);
+		printf("adopt full: %d\n", safe_string_error_val()); /* no room left for the terminator */
+
+		safe_string_swap(adopted, other);
+		printf("swap: %s | %s same buffer? %s\n", adopted->s_string, other->s_string, other->s_string == buffer ? "yes" : "no");
+
+		safe_string_move(target, other);
+		printf("move: %s | [%s] %lu same buffer? %s\n", target->s_string, other->s_string, safe_string_length(other), target->s_string == buffer ? "yes" : "no");
+
+		released = safe_string_release(target, &length); /* deletes the string */
+		printf("release: %s %lu same buffer? %s\n", released, length, released == buffer ? "yes" : "no");
+		safe_string_free(released);
+
+		released = safe_string_release(other, &length); /* an inline string hands out a copy */
+		printf("release inline: [%s] %lu\n", released, length);
+		safe_string_free(released);
+
+		safe_string_move(adopted, SAFE_STRING_INVALID);
+		printf("move null: %d\n", safe_string_error_val());
+		safe_string_delete(adopted);
+	}
+
+	{
+		const char binary[] = { 'a', '\0', 'b', '\0', 'c', 'd', '\0', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', '\0', 'p' };
+		s_string_t data = safe_string_new_length(binary, sizeof(binary)), part, copy, nul = safe_string_new_length("", 1), empty;
+		s_strings_t chunks;
+		unsigned long int chunk_count = 0;
+		safe_string_arena_t arena = safe_string_arena_new(0);
+
+		printf("binary: %lu intact? %s terminated? %s\n", safe_string_length(data), !memcmp(data->s_string, binary, sizeof(binary)) ? "yes" : "no", data->s_string[sizeof(binary)] == '\0' ? "yes" : "no");
+
+		part = safe_string_substring(data, 1, 5);
+		copy = safe_string_duplicate(data);
+		printf("binary substring: %lu %s duplicate: %lu %s\n", safe_string_length(part), !memcmp(part->s_string, binary + 1, 4) ? "intact" : "corrupt", safe_string_length(copy), !memcmp(copy->s_string, binary, sizeof(binary)) ? "intact" : "corrupt");
+		safe_string_delete(part);
+		safe_string_delete(copy);
+
+		chunks = safe_string_split(data, nul, &chunk_count);
+		printf("binary split:");
+		for(i = 0; i < chunk_count; i++) {
+			printf(" [%s]", chunks[i]->s_string);
+		}
+		printf("\n");
+		safe_string_array_delete(chunks, chunk_count);
+
+		chunks = safe_string_chunk_split(data, 8, NULL, &chunk_count);
+		printf("binary chunks: %lu lengths %lu %lu %lu\n", chunk_count, safe_string_length(chunks[0]), safe_string_length(chunks[1]), safe_string_length(chunks[2]));
+		safe_string_array_delete(chunks, chunk_count);
+
+		part = safe_string_new_length_in(arena, binary, 3);
+		empty = safe_string_new_length(SAFE_STRING_INVALID, 0);
+		printf("binary arena: %lu %s empty: %lu %s\n", safe_string_length(part), (part->s_flags & _S_STRING_FLAG_ARENA) ? "arena" : "heap", safe_string_length(empty), safe_string_valid(empty) ? "valid" : "invalid");
+
+		safe_string_delete(empty);
+		safe_string_arena_delete(arena);
+		safe_string_delete(nul);
+		safe_string_delete(data);
+	}
+
+	{
+		SAFE_STRING_FIXED(fixed, 20);
+		s_string_t part = safe_string_new("0123456789"), source = safe_string_new("a source too long to fit within the storage"), too_small;
+		char small[sizeof(_s_string_t)];
+
+		safe_string_concatenate(fixed, part);
+		safe_string_concatenate(fixed, part);
+		printf("fixed: %s %lu error? %s on stack? %s\n", fixed->s_string, safe_string_length(fixed), safe_string_error() ? "yes" : "no", (char *)fixed->s_string > (char *)&fixed_storage && (char *)fixed->s_string < (char *)&fixed_storage + sizeof(fixed_storage) ? "yes" : "no");
+
+		safe_string_concatenate(fixed, part);
+		printf("fixed overflow: %d kept: %s\n", safe_string_error_val(), fixed->s_string);
+		safe_string_copy(fixed, source);
+		printf("fixed copy overflow: %d", safe_string_error_val());
+		safe_string_copy_limit(fixed, source, 20);
+		printf(" copy limit: %s\n", fixed->s_string);
+
+		safe_string_delete(fixed); /* a no-op, the caller owns the storage */
+		printf("fixed delete: %lu", safe_string_length(fixed));
+		too_small = safe_string_fixed(small, sizeof(small));
+		printf(" small storage: %s %d\n", too_small ? "string" : "invalid", safe_string_error_val());
+
+		safe_string_delete(source);
+		safe_string_delete(part);
+	}
+
+	{
+		const char *words[] = { "batched", "strings", SAFE_STRING_INVALID, "sharing one arena, with a string longer than the rest" };
+		unsigned long int lengths[] = { 5, 7, 0, 7 };
+		s_strings_t batch = safe_string_new_batch(words, SAFE_STRING_INVALID, 4), empty;
+
+		printf("batch:");
+		for(i = 0; i < 4; i++) {
+			printf(" [%s]", batch[i]->s_string);
+		}
+		printf(" arena? %s\n", (batch[0]->s_flags & batch[3]->s_flags & _S_STRING_FLAG_ARENA) ? "yes" : "no");
+
+		safe_string_concatenate(batch[0], batch[1]);
+		safe_string_delete(batch[1]); /* a no-op, the batch owns it */
+		printf("batch modify: %s %s\n", batch[0]->s_string, batch[1]->s_string);
+		safe_string_batch_delete(batch);
+
+		batch = safe_string_new_batch(words, lengths, 4);
+		printf("batch lengths: %lu %lu %lu %s\n", safe_string_length(batch[0]), safe_string_length(batch[2]), safe_string_length(batch[3]), batch[3]->s_string);
+		safe_string_batch_delete(batch);
+
+		empty = safe_string_new_batch(SAFE_STRING_INVALID, SAFE_STRING_INVALID, 0);
+		printf("batch empty: %s %d", empty ? "array" : "invalid", safe_string_error_val());
+		safe_string_batch_delete(empty);
+		safe_string_new_batch(SAFE_STRING_INVALID, SAFE_STRING_INVALID, 2);
+		printf(" null: %d\n", safe_string_error_val());
+	}
+
+	{
+		static _s_string_t greeting = SAFE_STRING_LITERAL_INIT("hello");
+		s_string_t literal = SAFE_STRING_LITERAL("read-only"), joined, words[] = { safe_string_new("a"), safe_string_new("b"), safe_string_new("c") };
+		s_strings_t pieces;
+		unsigned long int piece_count = 0;
+
+		safe_string_index_set(literal, 0, 'R');
+		printf("literal: %s %lu modify: %d", literal->s_string, safe_string_length(literal), safe_string_error_val());
+		safe_string_concatenate(&greeting, literal);
+		printf(" concatenate: %d", safe_string_error_val());
+		safe_string_delete(literal); /* a no-op, literals are never freed */
+		printf(" delete kept: %s\n", literal->s_string);
+
+		joined = safe_string_join_limit_char(words, 3, SAFE_STRING_INVALID, 3); /* a NULL C string joins with nothing, as "" does */
+		printf("join null: %s error? %s", joined->s_string, safe_string_error() ? "yes" : "no");
+		safe_string_delete(joined);
+		joined = safe_string_rpad_char(&greeting, SAFE_STRING_INVALID, 8);
+		printf(" pad null: %s %d\n", joined ? joined->s_string : "invalid", safe_string_error_val());
+
+#ifdef SAFE_STRING_GENERIC
+		pieces = safe_string_split(&greeting, "l", &piece_count); /* dispatched to safe_string_split_char */
+		printf("generic: %lu", piece_count);
+		safe_string_array_delete(pieces, piece_count);
+		pieces = safe_string_split(&greeting, SAFE_STRING_LITERAL("ll"), &piece_count);
+		printf(" %lu", piece_count);
+		safe_string_array_delete(pieces, piece_count);
+		joined = safe_string_join(words, 3, ", ");
+		printf(" %s\n", joined->s_string);
+		safe_string_delete(joined);
+#else
+		pieces = safe_string_split_char(&greeting, "l", &piece_count);
+		safe_string_array_delete(pieces, piece_count);
+		printf("generic: unavailable\n");
+#endif
+
+		for(i = 0; i < 3; i++) {
+			safe_string_delete(words[i]);
+		}
+	}
+
+	{
+		s_string_t sized = safe_string_new("sized");
+
+#ifdef SAFE_STRING_COMPACT
+		safe_string_reserve(sized, SAFE_STRING_SIZE_MAX); /* with the terminator, one more than the sizes can hold */
+		printf("compact: %lu bytes, beyond the limit: %d", (unsigned long int)sizeof(_s_string_t), safe_string_error_val());
+		printf(" kept: %s %lu\n", sized->s_string, safe_string_length(sized));
+#else
+		printf("compact: off, %lu bytes, limit: %s\n", (unsigned long int)sizeof(_s_string_t), SAFE_STRING_SIZE_MAX == ~0UL ? "unbounded" : "bounded");
+#endif
+
+		safe_string_reserve(sized, 100);
+		printf("compact sizes: %lu %s\n", safe_string_length(sized), sized->s_capacity >= 101 ? "reserved" : "short");
+		safe_string_delete(sized);
+	}
+
+	{
+		safe_strings_vec_t vec = safe_strings_vec_new(1);
+		s_string_t taken, listed;
+
+		safe_strings_vec_push(vec, safe_string_new("second"));
+		safe_strings_vec_push(vec, safe_string_new("third")); /* grows past the initial capacity */
+		safe_strings_vec_insert(vec, 0, safe_string_new("first"));
+		printf("vec: %lu %s %s %s valid? %s\n", safe_strings_vec_count(vec), safe_strings_vec_index(vec, 0)->s_string, safe_strings_vec_index(vec, 1)->s_string, safe_strings_vec_index(vec, 2)->s_string, safe_strings_vec_valid(vec) ? "yes" : "no");
+
+		safe_strings_vec_push(vec, SAFE_STRING_INVALID);
+		printf("vec invalid pushed: valid? %s", safe_strings_vec_valid(vec) ? "yes" : "no");
+		taken = safe_strings_vec_pop(vec);
+		printf(" popped: valid? %s %s\n", safe_strings_vec_valid(vec) ? "yes" : "no", taken ? "string" : "invalid");
+
+		listed = safe_string_join_char(safe_strings_vec_array(vec), safe_strings_vec_count(vec), "+");
+		taken = safe_strings_vec_remove(vec, 1);
+		printf("vec array: %s removed: %s left: %lu\n", listed->s_string, taken->s_string, safe_strings_vec_count(vec));
+		safe_string_delete(taken);
+		safe_string_delete(listed);
+
+		safe_strings_vec_erase(vec, 0);
+		printf("vec erase: %lu %s", safe_strings_vec_count(vec), safe_strings_vec_index(vec, 0)->s_string);
+		safe_strings_vec_index(vec, 1);
+		printf(" bounds: %d", safe_string_error_val());
+		taken = safe_string_new("far");
+		safe_strings_vec_insert(vec, 5, taken);
+		printf(" insert bounds: %d\n", safe_string_error_val());
+		safe_string_delete(taken); /* still owned by the caller */
+		safe_strings_vec_delete(vec);
+
+		taken = safe_string_new("x;y;z");
+		listed = safe_string_new(";");
+		vec = safe_string_split_vec(taken, listed);
+		printf("vec split: %lu valid? %s null: %s\n", safe_strings_vec_count(vec), safe_strings_vec_valid(vec) ? "yes" : "no", safe_strings_vec_valid(SAFE_STRING_INVALID) ? "valid" : "invalid");
+		safe_strings_vec_delete(vec);
+		safe_string_delete(listed);
+		safe_string_delete(taken);
+	}
+
+	{
+		char range[41] = "0123456789abcdefghijABCDEFGHIJ0123456789";
+		unsigned char table[_S_RANGE_TABLE_SIZE];
+		s_string_t padded = safe_string_new("  \t trimmed around the words \n "), upper = safe_string_new("A LONGER STRING THAN A WORD, COMPARED WITHOUT CASE"), lower = safe_string_new("a longer string than a word, compared without case");
+
+		_safe_string_range_copy(range + 2, range, 20); /* overlaps the source */
+		printf("kernel copy: %.40s", range);
+		_safe_string_range_fill(range, '-', 5);
+		printf(" fill: %.10s\n", range);
+
+		printf("kernel compare: %d %d %d", _safe_string_range_compare("abcdefghijklmnopq", "abcdefghijklmnopq", 17), _safe_string_range_compare("abcdefghijklmnopq", "abcdefghijklmnopr", 17) < 0, _safe_string_range_compare("abcdefghijklmnopz", "abcdefghijklmnopq", 16));
+		printf(" case: %d %d\n", _safe_string_range_case_compare("Word Sized Chunks!", "wORD sIZED cHUNKS!", 18), _safe_string_range_case_compare("Word", "wore", 4) < 0);
+
+		_safe_string_range_table(table, " \t\n", 3);
+		printf("kernel scan: %lu %lu %lu", _safe_string_range_scan(padded->s_string, safe_string_length(padded), table, 0), _safe_string_range_scan_reverse(padded->s_string, safe_string_length(padded), table, 0), _safe_string_range_scan("abc", 3, table, 1));
+		memcpy(range, "reversed", 9);
+		_safe_string_range_reverse(range, 8);
+		printf(" reverse: %s\n", range);
+
+		padded = safe_string_trim(padded);
+		printf("kernel trim: [%s] case compare: %d locate set: ", padded->s_string, safe_string_case_compare(upper, lower));
+		if(safe_string_locate_set_char(padded, "xyzw", &i)) {
+			printf("%lu", i);
+		}
+		if(!safe_string_locate_set_char(padded, "xyz", &i)) {
+			printf(" none %d\n", safe_string_error_val());
+		}
+
+		safe_string_delete(lower);
+		safe_string_delete(upper);
+		safe_string_delete(padded);
+	}
+
+	{
+		s_string_t status = safe_string_new("status"), tail = safe_string_new(" codes");
+		s_string_error_t error;
+		unsigned long int length = 0;
+		unsigned char c = 0;
+		int diff = 0;
+
+		safe_string_index(status, 100); /* leaves SAFE_STRING_ERROR_INDEX_BOUNDS behind */
+		error = safe_string_length_r(status, &length);
+		printf("status length: %d %lu", error, length);
+		error = safe_string_index_r(status, 1, &c);
+		printf(" index: %d %c", error, c);
+		printf(" bounds: %d", safe_string_index_r(status, 100, &c));
+		printf(" set: %d", safe_string_index_set_r(status, 0, 'S'));
+		printf(" error kept: %d\n", safe_string_error_val());
+
+		printf("status concatenate: %d", safe_string_concatenate_r(status, tail));
+		error = safe_string_compare_r(status, tail, &diff);
+		printf(" compare: %d %d", error, diff > 0);
+		error = safe_string_compare_limit_r(status, status, 3, &diff);
+		printf(" limit: %d %d", error, diff);
+		error = safe_string_copy_limit_r(status, tail, 3);
+		printf(" copy: %d [%s]", error, status->s_string);
+		printf(" null: %d %d", safe_string_length_r(SAFE_STRING_INVALID, &length), safe_string_copy_r(status, SAFE_STRING_INVALID));
+		printf(" literal: %d", safe_string_concatenate_r(SAFE_STRING_LITERAL("fixed"), tail));
+		printf(" error kept: %d\n", safe_string_error_val());
+
+		safe_string_delete(tail);
+		safe_string_delete(status);
+	}
+
+	{
+		s_string_t accessed = safe_string_new("inline"), literal = SAFE_STRING_LITERAL("literal");
+		unsigned long int indices[] = { 0, 5, 6, 100 }, inline_length = 0, library_length = 0;
+		s_string_t strings[] = { accessed, SAFE_STRING_INVALID };
+		s_string_error_t inline_error, library_error;
+		unsigned char inline_c = 0, library_c = 0;
+		int matches = 1;
+
+		for(i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+			inline_length = safe_string_length(strings[i]);
+			inline_error = safe_string_error_val();
+			library_length = (safe_string_length)(strings[i]);
+			library_error = safe_string_error_val();
+			matches &= inline_length == library_length && inline_error == library_error;
+			inline_error = safe_string_length_r(strings[i], &inline_length);
+			library_error = (safe_string_length_r)(strings[i], &library_length);
+			matches &= inline_length == library_length && inline_error == library_error;
+			matches &= safe_string_length_r(strings[i], NULL) == (safe_string_length_r)(strings[i], NULL);
+			matches &= safe_string_access_characters(strings[i], &inline_length) == (safe_string_access_characters)(strings[i], &library_length);
+			for(j = 0; j < sizeof(indices) / sizeof(indices[0]); j++) {
+				inline_c = safe_string_index(strings[i], indices[j]);
+				inline_error = safe_string_error_val();
+				library_c = (safe_string_index)(strings[i], indices[j]);
+				library_error = safe_string_error_val();
+				matches &= inline_c == library_c && inline_error == library_error;
+				inline_error = safe_string_index_r(strings[i], indices[j], &inline_c);
+				library_error = (safe_string_index_r)(strings[i], indices[j], &library_c);
+				matches &= inline_c == library_c && inline_error == library_error;
+			}
+		}
+		matches &= safe_string_index_set_r(accessed, 0, 'I') == (safe_string_index_set_r)(accessed, 1, 'N');
+		matches &= safe_string_index_set_r(accessed, 100, 'x') == (safe_string_index_set_r)(accessed, 100, 'x');
+		matches &= safe_string_index_set_r(literal, 0, 'L') == (safe_string_index_set_r)(literal, 0, 'L');
+		safe_string_index_set(literal, 0, 'L');
+		inline_error = safe_string_error_val();
+		(safe_string_index_set)(literal, 0, 'L');
+		library_error = safe_string_error_val();
+		matches &= inline_error == library_error;
+#ifdef SAFE_STRING_INLINE
+		printf("inline accessors: on");
+#else
+		printf("inline accessors: off");
+#endif
+		printf(" match library? %s [%s] literal: %d\n", matches ? "yes" : "no", safe_string_access_characters(accessed, NULL), library_error);
+		safe_string_delete(accessed);
+	}
+
 	printf("buffer: %s", str->s_string);
 	
 	safe_string_delete(str);
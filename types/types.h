@@ -33,20 +33,176 @@
 #ifndef _SAFE_STRING_TYPES_TYPES_H_
 #define _SAFE_STRING_TYPES_TYPES_H_
 
+#include <stdint.h>
+
 #define SAFE_STRING_INVALID (void *)0 /*!< Represents the empty string */
 #define SAFE_STRING_EMPTY 0 /*!< Length of the empty string */
+#define SAFE_STRING_INLINE_SIZE 16 /*!< Size of the buffer stored within the string structure for short strings */
+
+/*
+ * Defining SAFE_STRING_COMPACT stores the sizes of each string in 32 bits and
+ * it's flags in 8, shrinking the string structure from 32 to 24 bytes; strings
+ * are then limited to SAFE_STRING_SIZE_MAX bytes and operations needing more fail
+ * with SAFE_STRING_ERROR_MEM_ALLOC.
+ *
+ * The library and everything including it's headers must be compiled with the
+ * same SAFE_STRING_COMPACT and SAFE_STRING_NO_INLINE settings (and the same C
+ * standard, which decides SAFE_STRING_INLINE), since they change the layout of
+ * the string structure and the code the headers expand to; mixing them corrupts
+ * strings without any error.
+ */
+#ifdef SAFE_STRING_COMPACT
+typedef uint32_t _s_string_size_t; /*!< (INTERNAL) Type holding the sizes of a string's buffer */
+typedef uint8_t _s_string_flags_t; /*!< (INTERNAL) Type holding the flags of a string */
+#define SAFE_STRING_SIZE_MAX 0xffffffffUL /*!< Largest buffer a string can hold (including the terminator) */
+#else
+typedef unsigned long int _s_string_size_t; /*!< (INTERNAL) Type holding the sizes of a string's buffer */
+typedef unsigned int _s_string_flags_t; /*!< (INTERNAL) Type holding the flags of a string */
+#define SAFE_STRING_SIZE_MAX (~0UL) /*!< Largest buffer a string can hold (including the terminator) */
+#endif
 
 /*! 
  * @brief The base string structure (only used internally)
  */
 struct _s_string_t { 
 	char *s_string; /*!< Internal buffer storing the string contents */
-	unsigned long int s_length; /*!< Represents the size of the buffer */
+	_s_string_size_t s_length; /*!< Represents the used size of the buffer (including the terminator) */
+	_s_string_size_t s_capacity; /*!< Represents the allocated size of the buffer */
+	_s_string_flags_t s_flags; /*!< (INTERNAL) Describes who owns the structure and the buffer */
+	uint32_t s_embedded; /*!< (INTERNAL) Size of the buffer allocated along with a heap string's structure when larger than SAFE_STRING_INLINE_SIZE, 0 otherwise */
+	char s_inline[]; /*!< Buffer allocated along with the structure, at least SAFE_STRING_INLINE_SIZE in size */
+};
+
+#define _S_STRING_FLAG_ARENA 0x01 /*!< (INTERNAL) The structure and buffer are owned by an arena */
+#define _S_STRING_FLAG_SHARED 0x02 /*!< (INTERNAL) The buffer is reference counted and may be shared with other strings */
+#define _S_STRING_FLAG_FIXED 0x04 /*!< (INTERNAL) The structure and buffer are storage provided by the caller, which can't grow */
+#define _S_STRING_FLAG_MAPPED 0x08 /*!< (INTERNAL) The buffer is a read-only mapping of a file */
+#define _S_STRING_FLAG_LARGE 0x10 /*!< (INTERNAL) The buffer is an anonymous mapping, resized with mremap */
+#define _S_STRING_FLAG_LITERAL 0x20 /*!< (INTERNAL) The structure and buffer are static (or borrowed from the caller) and read-only */
+#define _S_STRING_FLAG_UNMANAGED (_S_STRING_FLAG_ARENA | _S_STRING_FLAG_FIXED | _S_STRING_FLAG_LITERAL) /*!< (INTERNAL) Flags of strings which aren't released to the heap */
+#define _S_STRING_FLAG_FOREIGN (_S_STRING_FLAG_SHARED | _S_STRING_FLAG_MAPPED) /*!< (INTERNAL) Flags of buffers which are copied before being modified */
+#define _S_STRING_FLAG_BUFFER (_S_STRING_FLAG_FOREIGN | _S_STRING_FLAG_LARGE) /*!< (INTERNAL) Flags describing the buffer, which move along with it */
+
+/*!
+ * @brief A reference counted buffer which can be shared between strings (only
+ * used internally)
+ */
+struct _s_string_shared_t {
+	unsigned long int s_references; /*!< Amount of strings using the buffer (updated atomically) */
+	char s_data[]; /*!< The buffer the strings point to */
+};
+
+/*!
+ * @brief A block of memory strings are carved out of (only used internally)
+ */
+struct _s_string_arena_block_t {
+	struct _s_string_arena_block_t *next; /*!< Next block owned by the arena */
+	unsigned long int size; /*!< Amount of usable bytes within the block */
+	unsigned long int used; /*!< Amount of bytes handed out from the block */
+	char data[]; /*!< The memory handed out from the block */
+};
+
+/*!
+ * @brief Arena which strings can be bump allocated from and released in bulk
+ * (only used internally)
+ */
+struct _s_string_arena_t {
+	struct _s_string_arena_block_t *blocks; /*!< Blocks owned by the arena, the current block first */
+	unsigned long int block_size; /*!< Default size of each block */
+};
+
+/*!
+ * @brief Table mapping string contents to a single canonical string and a
+ * 32-bit identifier (only used internally)
+ */
+struct _s_string_intern_t {
+	struct _s_string_t **strings; /*!< Canonical strings, indexed by identifier */
+	uint32_t *hashes; /*!< Hash of each canonical string, indexed by identifier */
+	uint32_t *slots; /*!< Open addressed hash table of identifiers (offset by one, 0 marks an empty slot) */
+	unsigned long int count; /*!< Amount of canonical strings */
+	unsigned long int capacity; /*!< Amount of canonical strings the arrays can hold */
+	unsigned long int slot_count; /*!< Amount of slots within the hash table (a power of two) */
+};
+
+/*!
+ * @brief Location of a single string within a packed array (only used internally)
+ */
+struct _s_strings_packed_entry_t {
+	unsigned long int offset; /*!< Offset of the string within the packed buffer */
+	unsigned long int length; /*!< Length of the string (excluding the terminator) */
+};
+
+/*!
+ * @brief Array of strings stored in a single allocation: the table of entries
+ * is followed by one buffer holding every string, each terminated (only used
+ * internally)
+ */
+struct _s_strings_packed_t {
+	unsigned long int count; /*!< Amount of strings within the array */
+	unsigned long int size; /*!< Amount of bytes used within the buffer */
+	char *data; /*!< Buffer containing the strings */
+	struct _s_strings_packed_entry_t entries[]; /*!< Location of each string within the buffer */
+};
+
+/*!
+ * @brief Growable array of strings which carries it's own count and owns the
+ * strings within it (only used internally)
+ */
+struct _s_strings_vec_t {
+	struct _s_string_t **v_strings; /*!< Strings held by the vector, some may be invalid */
+	unsigned long int v_count; /*!< Amount of strings within the vector */
+	unsigned long int v_capacity; /*!< Amount of strings the array can hold */
+	unsigned long int v_invalid; /*!< Amount of invalid strings within the vector (0 when all are valid) */
+};
+
+/*!
+ * @brief Non-owning reference to a range of characters within another string;
+ * it remains valid only while the characters it refers to are alive and
+ * unmodified
+ */
+typedef struct {
+	const char *v_string; /*!< First character of the range (not necessarily terminated) */
+	unsigned long int v_length; /*!< Amount of characters within the range */
+} s_string_view_t;
+
+/*!
+ * @brief A node of a rope: either a leaf holding a chunk of characters, or the
+ * concatenation of two child ropes (only used internally)
+ */
+struct _s_string_rope_node_t {
+	struct _s_string_rope_node_t *left; /*!< Characters at the start of the node (SAFE_STRING_INVALID for leaves) */
+	struct _s_string_rope_node_t *right; /*!< Characters at the end of the node (SAFE_STRING_INVALID for leaves) */
+	unsigned long int length; /*!< Amount of characters held beneath the node */
+	unsigned int height; /*!< Height of the node (leaves have a height of 1) */
+	char data[]; /*!< Characters held by a leaf (not terminated) */
+};
+
+/*!
+ * @brief A string stored as a balanced tree of chunks (only used internally)
+ */
+struct _s_string_rope_t {
+	struct _s_string_rope_node_t *root; /*!< Root of the tree (SAFE_STRING_INVALID when empty) */
 };
 
+#define SAFE_STRING_ROPE_HEIGHT_LIMIT 96 /*!< Upper bound on the height of a rope (enough for any addressable length) */
+
+/*!
+ * @brief Iterator over the chunks of a rope; it becomes invalid once the rope
+ * is modified
+ */
+typedef struct {
+	struct _s_string_rope_node_t *i_stack[SAFE_STRING_ROPE_HEIGHT_LIMIT]; /*!< Nodes whose right-hand sides remain to be visited */
+	unsigned int i_depth; /*!< Amount of nodes on the stack */
+} s_string_rope_iterator_t;
+
 typedef struct _s_string_t _s_string_t; /*!< Internal base string type */
 typedef struct _s_string_t *s_string_t; /*!< Base string type */
 typedef s_string_t *s_strings_t; /*!< Array of strings type */
+typedef struct _s_string_arena_t *safe_string_arena_t; /*!< Arena type */
+typedef struct _s_string_intern_t *safe_string_intern_t; /*!< Interning table type */
+typedef struct _s_string_rope_t *safe_string_rope_t; /*!< Rope type */
+typedef struct _s_strings_packed_t *s_strings_packed_t; /*!< Packed array of strings type */
+typedef struct _s_strings_vec_t *safe_strings_vec_t; /*!< Vector of strings type */
 
 /*!
  * @brief Macro to test validity of a safe string variable
@@ -55,6 +211,86 @@ typedef s_string_t *s_strings_t; /*!< Array of strings type */
  */
 #define safe_string_valid(s) ((s) && (s)->s_string)
 
+/*!
+ * @brief Macro to test validity of a string view
+ * @param v source view
+ * @return Boolean value of true if valid, else false
+ */
+#define safe_string_view_valid(v) ((v).v_string != SAFE_STRING_INVALID)
+
+/*!
+ * @brief Initializer for a string structure referring to a string literal,
+ * which is never freed and can't be modified
+ * @param s string literal
+ * @note This is the portable way to refer to a literal, by initializing a named
+ * static structure and using it's address:
+ * static _s_string_t hello = SAFE_STRING_LITERAL_INIT("hello");
+ * safe_string_concatenate(str, &hello);
+ */
+#define SAFE_STRING_LITERAL_INIT(s) { (char *)("" s), sizeof(s), sizeof(s), _S_STRING_FLAG_LITERAL, 0 }
+
+#if defined(__GNUC__)
+/*!
+ * @brief Macro to obtain a string referring to a string literal, without
+ * allocating; the string is static, so it is valid for the life of the program,
+ * and operations which would modify it fail with SAFE_STRING_ERROR_READ_ONLY
+ * @param s string literal
+ * @return The string
+ * @note Only available with compilers supporting GNU statement expressions,
+ * otherwise use SAFE_STRING_LITERAL_INIT with a named static structure
+ */
+#define SAFE_STRING_LITERAL(s) ({ static _s_string_t _s_literal = SAFE_STRING_LITERAL_INIT(s); (s_string_t)&_s_literal; })
+#endif
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(SAFE_STRING_NO_GENERIC)
+#define SAFE_STRING_GENERIC 1 /*!< Functions taking a string argument also accept a C string in it's place */
+
+/*!
+ * @brief (INTERNAL) Macro to select the variant of a function taking a C string
+ * when an argument is one, and the function itself otherwise
+ * @param x argument to dispatch on
+ * @param f function taking a string (the C string variant has the _char suffix)
+ * @return The selected function
+ */
+#define _safe_string_generic(x, f) _Generic((x), char *: f##_char, const char *: f##_char, default: f)
+#endif
+
+/* must match between the library and it's users, see SAFE_STRING_COMPACT */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L && !defined(SAFE_STRING_NO_INLINE)
+#define SAFE_STRING_INLINE 1 /*!< The hot accessors are defined inline within the headers, falling back to the library for errors */
+#endif
+
+/*!
+ * @brief (INTERNAL) Macro to construct a string view
+ * @param s first character of the range
+ * @param l amount of characters within the range
+ * @return The view
+ */
+#define _safe_string_view_make(s, l) ((s_string_view_t){ (s), (l) })
+
+/*!
+ * @brief (INTERNAL) Macro to test if a string's contents are stored within the
+ * string structure itself
+ * @param s source string
+ * @return Boolean value of true if stored inline, else false
+ */
+#define _safe_string_inline(s) ((s)->s_string == (s)->s_inline)
+
+/*!
+ * @brief (INTERNAL) Macro to obtain the arena a string was allocated from (the
+ * arena is stored immediately before the structure)
+ * @param s source string (must have the _S_STRING_FLAG_ARENA flag set)
+ * @return The arena owning the string
+ */
+#define _safe_string_arena(s) (((safe_string_arena_t *)(s))[-1])
+
+/*!
+ * @brief (INTERNAL) Macro to obtain the reference counted buffer a string points to
+ * @param s source string (must have the _S_STRING_FLAG_SHARED flag set)
+ * @return The shared buffer
+ */
+#define _safe_string_shared(s) (((struct _s_string_shared_t *)(s)->s_string) - 1)
+
 /*!
  * @brief Function to test if an array of safe string variables is valid
  * @param strs array of source strings
@@ -35,5 +35,13 @@
 
 #include "universal/allocate.h"
 #include "universal/error.h"
+#include "universal/allocator.h"
+#include "universal/arena.h"
+#include "universal/cache.h"
+#include "universal/intern.h"
+#include "universal/stats.h"
+#include "universal/map.h"
+#include "universal/batch.h"
+#include "universal/kernel.h"
 
 #endif
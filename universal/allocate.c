@@ -30,9 +30,369 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdlib.h> /* calloc, free */
+#include <string.h> /* memcpy, memset, strlen */
 #include "types/types.h"
 #include "universal.h"
+#include "macro.h"
+
+#define _S_CAPACITY_MINIMUM (SAFE_STRING_INLINE_SIZE * 2) /*!< (INTERNAL) Smallest buffer size allocated when a string moves to the heap */
+#define _S_CAPACITY_LARGE (1UL << 20) /*!< (INTERNAL) Smallest buffer size backed by an anonymous mapping rather than the allocator */
+
+/*!
+ * @brief (INTERNAL) Calculates the bytes a heap string holds for the statistics;
+ * a shared buffer is counted once, by itself, rather than by each string using
+ * it, and a mapped file isn't counted
+ * @param str source string (must not be owned by an arena)
+ * @return The amount of bytes held
+ * @note The structure is counted at the size it was allocated with, which
+ * remains the same when it's contents move out of it
+ */
+static long int _safe_string_footprint(s_string_t str)
+{
+	long int structure = sizeof(_s_string_t) + (str->s_embedded ? str->s_embedded : SAFE_STRING_INLINE_SIZE);
+
+	if((str->s_flags & _S_STRING_FLAG_FOREIGN) || _safe_string_inline(str)) {
+		return(structure);
+	} else {
+		return(structure + str->s_capacity);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Drops a string's reference to it's shared buffer, releasing
+ * the buffer once no other string uses it
+ * @param str source string (must have the _S_STRING_FLAG_SHARED flag set)
+ */
+static void _safe_string_shared_release(s_string_t str)
+{
+	struct _s_string_shared_t *shared = _safe_string_shared(str);
+
+	if(!__atomic_sub_fetch(&shared->s_references, 1, __ATOMIC_ACQ_REL)) {
+		_safe_string_stats_live(0, -(long int)(sizeof(struct _s_string_shared_t) + str->s_capacity));
+		_safe_string_free(shared);
+	}
+
+	str->s_flags &= ~_S_STRING_FLAG_SHARED;
+}
+
+/*!
+ * @brief (INTERNAL) Drops a string's hold on a shared buffer or a mapped file
+ * @param str source string (must have one of the _S_STRING_FLAG_FOREIGN flags set)
+ */
+static void _safe_string_foreign_release(s_string_t str)
+{
+	if(str->s_flags & _S_STRING_FLAG_SHARED) {
+		_safe_string_shared_release(str);
+	} else {
+		_safe_string_unmap(str);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Releases a buffer owned by a string alone, whether from the
+ * allocator or an anonymous mapping
+ * @param str source string (must hold it's buffer outside of it's structure, and
+ * not be owned by an arena)
+ */
+static void _safe_string_buffer_release(s_string_t str)
+{
+	if(str->s_flags & _S_STRING_FLAG_LARGE) {
+		_safe_string_map_release(str->s_string, str->s_capacity);
+		str->s_flags &= ~_S_STRING_FLAG_LARGE;
+	} else {
+		_safe_string_cache_release(str->s_string, str->s_capacity);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Moves a string out of it's shared buffer or mapped file into
+ * a buffer of it's own, either embedded or on the heap
+ * @param str destination string (must have one of the _S_STRING_FLAG_FOREIGN flags set)
+ * @param capacity size of the new buffer (must be at least the used size)
+ * @return Non-zero on success, zero otherwise
+ */
+static int _safe_string_privatize(s_string_t str, unsigned long int capacity)
+{
+	char *new = str->s_inline;
+
+	if(capacity > SAFE_STRING_INLINE_SIZE) {
+		if(!(new = (char *)_safe_string_cache_allocate((capacity = _safe_string_cache_size(capacity)) * sizeof(char)))) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_REALLOCATE, capacity);
+	} else {
+		capacity = SAFE_STRING_INLINE_SIZE; /* every structure embeds at least this much */
+	}
+
+	memcpy(new, str->s_string, str->s_length);
+	_safe_string_stats_copy(str->s_length);
+	_safe_string_foreign_release(str);
+	str->s_string = new;
+	str->s_capacity = capacity;
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief (INTERNAL) Changes the size of a string's buffer, moving it between the
+ * embedded buffer and the heap as required
+ * @param str destination string
+ * @param capacity new size of the buffer (must be at least the used size)
+ * @return Non-zero on success, zero otherwise
+ */
+static int _safe_string_reallocate(s_string_t str, unsigned long int capacity)
+{
+	long int footprint = (str->s_flags & _S_STRING_FLAG_UNMANAGED) ? 0 : _safe_string_footprint(str);
+
+	if(str->s_flags & _S_STRING_FLAG_LITERAL) {
+		return(SAFE_STRING_EMPTY); /* literals are read-only */
+	} else if(capacity > SAFE_STRING_SIZE_MAX) {
+		return(SAFE_STRING_EMPTY); /* too large to be held by a string */
+	} else if(str->s_flags & _S_STRING_FLAG_FOREIGN) {
+		if(!_safe_string_privatize(str, capacity)) {
+			return(SAFE_STRING_EMPTY);
+		}
+	} else if(_safe_string_inline(str) && capacity <= str->s_capacity) {
+		; /* already fits within the embedded buffer */
+	} else if(str->s_flags & _S_STRING_FLAG_FIXED) {
+		return(SAFE_STRING_EMPTY); /* the caller's storage can't grow */
+	} else if(capacity <= SAFE_STRING_INLINE_SIZE) {
+		memcpy(str->s_inline, str->s_string, str->s_length); /* every structure embeds at least this much */
+		_safe_string_stats_copy(str->s_length);
+		if(!(str->s_flags & _S_STRING_FLAG_ARENA)) {
+			_safe_string_buffer_release(str);
+		}
+		str->s_string = str->s_inline;
+		str->s_capacity = SAFE_STRING_INLINE_SIZE;
+	} else if(str->s_flags & _S_STRING_FLAG_ARENA) {
+		char *new = (char *)_safe_string_arena_allocate(_safe_string_arena(str), capacity * sizeof(char));
+
+		if(!new) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		memcpy(new, str->s_string, str->s_length); /* the old buffer is released along with the arena */
+		_safe_string_stats_copy(str->s_length);
+		str->s_string = new;
+		str->s_capacity = capacity;
+	} else if((str->s_flags & _S_STRING_FLAG_LARGE) || (capacity >= _S_CAPACITY_LARGE && _safe_string_allocator_default())) {
+		char *new = SAFE_STRING_INVALID;
+
+		capacity = MIN(_safe_string_map_size(capacity), SAFE_STRING_SIZE_MAX);
+
+		if(str->s_flags & _S_STRING_FLAG_LARGE) {
+			new = (char *)_safe_string_map_reallocate(str->s_string, str->s_capacity, capacity); /* moves pages rather than copying them */
+		} else if((new = (char *)_safe_string_map_allocate(capacity))) {
+			memcpy(new, str->s_string, str->s_length);
+			_safe_string_stats_copy(str->s_length);
+
+			if(!_safe_string_inline(str)) {
+				_safe_string_cache_release(str->s_string, str->s_capacity);
+			}
+		}
+
+		if(!new) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_REALLOCATE, capacity);
+		str->s_string = new;
+		str->s_capacity = capacity;
+		str->s_flags |= _S_STRING_FLAG_LARGE;
+	} else if(_safe_string_inline(str)) {
+		char *new = (char *)_safe_string_cache_allocate((capacity = _safe_string_cache_size(capacity)) * sizeof(char));
+
+		if(!new) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		memcpy(new, str->s_inline, str->s_length);
+		_safe_string_stats_allocate(SAFE_STRING_STATS_REALLOCATE, capacity);
+		_safe_string_stats_copy(str->s_length);
+		str->s_string = new;
+		str->s_capacity = capacity;
+	} else {
+		char *new = (char *)_safe_string_realloc(str->s_string, (capacity = _safe_string_cache_size(capacity)) * sizeof(char));
+
+		if(!new) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_REALLOCATE, capacity);
+		str->s_string = new;
+		str->s_capacity = capacity;
+	}
+
+	if(!(str->s_flags & _S_STRING_FLAG_UNMANAGED)) {
+		_safe_string_stats_live(0, _safe_string_footprint(str) - footprint);
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a string of a given length with the structure and
+ * the buffer in a single block, counting it against a site within the statistics;
+ * the contents are left for the caller to fill in, followed by a terminator
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param length amount of characters the string holds
+ * @param site site the allocation is counted against
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Heap strings of _S_CAPACITY_LARGE or more hold their contents in a
+ * buffer of their own instead
+ */
+static s_string_t _safe_string_allocate_site(safe_string_arena_t arena, unsigned long int length, s_string_stats_site_t site)
+{
+	unsigned long int capacity = MAX(length + 1, SAFE_STRING_INLINE_SIZE);
+	s_string_t rstring;
+
+	if(length >= SAFE_STRING_SIZE_MAX) {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC); /* too long to be held by a string */
+		return(SAFE_STRING_INVALID);
+	} else if(arena) {
+		safe_string_arena_t *block = (safe_string_arena_t *)_safe_string_arena_allocate(arena, sizeof(safe_string_arena_t) + sizeof(_s_string_t) + capacity);
+
+		if(!block) {
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_string_arena_allocate */
+		}
+
+		block[0] = arena;
+		rstring = (s_string_t)(block + 1);
+		rstring->s_flags = _S_STRING_FLAG_ARENA;
+		rstring->s_string = rstring->s_inline;
+		rstring->s_capacity = capacity;
+	} else {
+		unsigned long int embedded = (capacity < _S_CAPACITY_LARGE) ? capacity : SAFE_STRING_INLINE_SIZE; /* large buffers are mapped on their own */
+
+		rstring = (embedded == SAFE_STRING_INLINE_SIZE) ? _safe_string_cache_allocate_header() : (s_string_t)_safe_string_malloc(sizeof(_s_string_t) + embedded);
+
+		if(!rstring) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		memset(rstring, 0, sizeof(_s_string_t)); /* the contents are written by the caller */
+		rstring->s_string = rstring->s_inline;
+		rstring->s_string[0] = '\0';
+		rstring->s_length = 1;
+		rstring->s_capacity = embedded;
+		rstring->s_embedded = (embedded > SAFE_STRING_INLINE_SIZE) ? embedded : 0;
+
+		_safe_string_stats_allocate(site, sizeof(_s_string_t) + embedded);
+		_safe_string_stats_live(1, sizeof(_s_string_t) + embedded);
+
+		if(capacity > embedded && !_safe_string_reallocate(rstring, capacity)) {
+			safe_string_delete(rstring);
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+	}
+
+	rstring->s_string[length] = '\0';
+	rstring->s_length = length + 1;
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	return(rstring);
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a string of a given length with the structure and
+ * the buffer in a single block; the contents are left for the caller to fill in,
+ * followed by a terminator
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param length amount of characters the string holds
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t _safe_string_allocate_in(safe_string_arena_t arena, unsigned long int length)
+{
+	return(_safe_string_allocate_site(arena, length, SAFE_STRING_STATS_ALLOCATE));
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a string holding a copy of a range of characters,
+ * counting it against a site within the statistics
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @param site site the allocation is counted against
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+static s_string_t _safe_string_new_length_site(safe_string_arena_t arena, const void *data, unsigned long int length, s_string_stats_site_t site)
+{
+	s_string_t rstring;
+
+	if(!data && length) {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+
+	if((rstring = _safe_string_allocate_site(arena, length, site)) && length) {
+		memcpy(rstring->s_string, data, length);
+		_safe_string_stats_copy(length);
+	}
+
+	return(rstring); /* use the error code from _safe_string_allocate_site */
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a string holding a copy of a range of characters,
+ * with the structure and the buffer in a single block
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t _safe_string_allocate_copy_in(safe_string_arena_t arena, const void *data, unsigned long int length)
+{
+	return(_safe_string_new_length_site(arena, data, length, SAFE_STRING_STATS_ALLOCATE));
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a string of a given length with the structure and
+ * the buffer in a single block; the contents are left for the caller to fill in,
+ * followed by a terminator
+ * @param length amount of characters the string holds
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t _safe_string_allocate(unsigned long int length)
+{
+	return(_safe_string_allocate_in(SAFE_STRING_INVALID, length));
+}
+
+/*!
+ * @brief (INTERNAL) Allocates an array of strings
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the array
+ * is allocated from the heap)
+ * @param count amount of elements within the array
+ * @return The newly created (zeroed) array, or SAFE_STRING_INVALID if there
+ * was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_strings_t _safe_string_array_allocate_in(safe_string_arena_t arena, unsigned long int count)
+{
+	s_strings_t retn;
+
+	if(arena) {
+		return((s_strings_t)_safe_string_arena_allocate(arena, count * sizeof(s_string_t)));
+	} else if((retn = (s_strings_t)_safe_string_calloc(count, sizeof(s_string_t)))) {
+		_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, count * sizeof(s_string_t));
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	}
+}
 
 /*!
  * @brief Allocates a new string with a given value
@@ -40,44 +400,49 @@
  * @return The newly created string, or an invalid string
  * if there was an error
  * @note Sets the error variable indicating success or failure
+ * @note Strings shorter than SAFE_STRING_INLINE_SIZE are stored within the
+ * string structure, requiring only a single allocation
  */
 s_string_t safe_string_new(const char *str)
 {
-	s_string_t rstring = (s_string_t)calloc(1, sizeof(_s_string_t));
+	s_string_t rstring = _safe_string_cache_allocate_header();
 	if(rstring) {
+		memset(rstring, 0, sizeof(_s_string_t) + SAFE_STRING_INLINE_SIZE);
+
 		if(str) {
-			unsigned long int i = 0, j = 0;
+			unsigned long int i = strlen(str) + 1; /* includes the terminator */
 
-			while(str[i++]) {
-				; /* calculate the buffer size */
+			if(i <= SAFE_STRING_INLINE_SIZE) {
+				rstring->s_string = rstring->s_inline;
+				rstring->s_capacity = SAFE_STRING_INLINE_SIZE;
+			} else if(i <= SAFE_STRING_SIZE_MAX) {
+				rstring->s_capacity = _safe_string_cache_size(i);
+				rstring->s_string = (char *)_safe_string_cache_allocate(rstring->s_capacity * sizeof(char));
 			}
 
-			rstring->s_string = (char *)calloc(i, sizeof(char));
-
 			if(!rstring->s_string) {
+				_safe_string_cache_release_header(rstring);
 				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 				return(SAFE_STRING_INVALID);
 			} else {
 				rstring->s_length = i;
+				memcpy(rstring->s_string, str, i);
 
-				for(i = j = 0; i < rstring->s_length; i++, j++) {
-					rstring->s_string[i] = str[j];
-				}
+				_safe_string_stats_allocate(SAFE_STRING_STATS_NEW, _safe_string_footprint(rstring));
+				_safe_string_stats_live(1, _safe_string_footprint(rstring));
+				_safe_string_stats_copy(rstring->s_length);
 				
 				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 				return(rstring);
 			}
 		} else {
-			rstring->s_string = (char *)calloc(1, sizeof(char));
-
-			if(!rstring->s_string) {
-				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-				return(SAFE_STRING_INVALID);
-			} else {
-				rstring->s_length = 1;
-				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-				return(rstring);
-			}
+			rstring->s_string = rstring->s_inline;
+			rstring->s_length = 1;
+			rstring->s_capacity = SAFE_STRING_INLINE_SIZE;
+			_safe_string_stats_allocate(SAFE_STRING_STATS_NEW, _safe_string_footprint(rstring));
+			_safe_string_stats_live(1, _safe_string_footprint(rstring));
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(rstring);
 		}
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
@@ -85,6 +450,67 @@ s_string_t safe_string_new(const char *str)
 	}
 }
 
+/*!
+ * @brief Allocates a new string with a given value, storing the structure and
+ * the contents in a single block
+ * @param str value to assign the string
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Intended for strings which are not grown afterwards; growing such a
+ * string moves it's contents into a separate buffer
+ */
+s_string_t safe_string_new_embedded(const char *str)
+{
+	return(safe_string_new_in(SAFE_STRING_INVALID, str));
+}
+
+/*!
+ * @brief Allocates a new string with a given value from an arena
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param str value to assign the string
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The string is released along with the arena, safe_string_delete has
+ * no effect upon it
+ */
+s_string_t safe_string_new_in(safe_string_arena_t arena, const char *str)
+{
+	return(_safe_string_new_length_site(arena, str, str ? strlen(str) : 0, SAFE_STRING_STATS_NEW));
+}
+
+/*!
+ * @brief Allocates a new string holding a given amount of characters from an
+ * arena, with the structure and the buffer in a single block
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_string_new_length_in(safe_string_arena_t arena, const void *data, unsigned long int length)
+{
+	return(_safe_string_new_length_site(arena, data, length, SAFE_STRING_STATS_NEW));
+}
+
+/*!
+ * @brief Allocates a new string holding a given amount of characters, with the
+ * structure and the buffer in a single block
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_string_new_length(const void *data, unsigned long int length)
+{
+	return(_safe_string_new_length_site(SAFE_STRING_INVALID, data, length, SAFE_STRING_STATS_NEW));
+}
+
 /*!
  * @brief Deletes a given string
  * @param str source string
@@ -92,11 +518,15 @@ s_string_t safe_string_new(const char *str)
  */
 void safe_string_delete(s_string_t str)
 {
-	if(str && str->s_length) {
-		free(str->s_string);
-		free(str);
-	} else if(str && !str->s_length) {
-		free(str);
+	if(str && !(str->s_flags & _S_STRING_FLAG_UNMANAGED)) {
+		_safe_string_stats_live(-1, -_safe_string_footprint(str));
+
+		if(str->s_flags & _S_STRING_FLAG_FOREIGN) {
+			_safe_string_foreign_release(str);
+		} else if(str->s_string && !_safe_string_inline(str)) {
+			_safe_string_buffer_release(str);
+		}
+		_safe_string_cache_release_header(str);
 	}
 
 	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
@@ -108,6 +538,8 @@ void safe_string_delete(s_string_t str)
  * @param strs source array of strings
  * @param count number of elements in the array
  * @note Sets the error variable indicating success or failure
+ * @note Arrays allocated from an arena must not be passed to this function,
+ * they are released along with the arena
  */
 void safe_string_array_delete(s_strings_t strs, unsigned long int count)
 {
@@ -119,10 +551,558 @@ void safe_string_array_delete(s_strings_t strs, unsigned long int count)
 				safe_string_delete(strs[i]);
 			}
 		}
-		free(strs);
+		_safe_string_free(strs);
 	}
 
 	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 	strs = SAFE_STRING_INVALID;
 }
 
+/*!
+ * @brief (INTERNAL) Determines why a string couldn't be modified
+ * @param str destination string
+ * @return SAFE_STRING_ERROR_READ_ONLY for literals, SAFE_STRING_ERROR_CAPACITY
+ * for fixed capacity strings and SAFE_STRING_ERROR_MEM_ALLOC otherwise
+ */
+s_string_error_t _safe_string_modify_error(s_string_t str)
+{
+	if(str->s_flags & _S_STRING_FLAG_LITERAL) {
+		return(SAFE_STRING_ERROR_READ_ONLY);
+	} else if(str->s_flags & _S_STRING_FLAG_FIXED) {
+		return(SAFE_STRING_ERROR_CAPACITY);
+	} else {
+		return(SAFE_STRING_ERROR_MEM_ALLOC);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Ensures a string's buffer can hold at least a given amount
+ * of characters (including the terminator); the buffer at least doubles in size
+ * when it has to be reallocated, making repeated appends amortized O(1)
+ * @param str destination string
+ * @param size minimum size of the buffer
+ * @return Error code indicating success or failure
+ * @note Does not touch the error variable
+ */
+s_string_error_t _safe_string_grow_r(s_string_t str, unsigned long int size)
+{
+	if(safe_string_valid(str)) {
+		if(size > str->s_capacity) {
+			unsigned long int capacity = MAX(MAX(size, (unsigned long int)str->s_capacity * 2), _S_CAPACITY_MINIMUM);
+
+			if(capacity > SAFE_STRING_SIZE_MAX && size <= SAFE_STRING_SIZE_MAX) {
+				capacity = SAFE_STRING_SIZE_MAX; /* doubling would exceed what a string can hold */
+			}
+
+			if(!_safe_string_reallocate(str, capacity)) {
+				return(_safe_string_modify_error(str));
+			}
+		} else if(!_safe_string_unshare(str)) {
+			return(_safe_string_modify_error(str));
+		}
+
+		return(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Ensures a string's buffer can hold at least a given amount
+ * of characters (including the terminator); the buffer at least doubles in size
+ * when it has to be reallocated, making repeated appends amortized O(1)
+ * @param str destination string
+ * @param size minimum size of the buffer
+ * @return Non-zero on success, zero otherwise
+ * @note Sets the error variable indicating success or failure
+ */
+int _safe_string_grow(s_string_t str, unsigned long int size)
+{
+	s_string_error_t error = _safe_string_grow_r(str, size);
+
+	safe_string_set_error(error);
+	return(error == SAFE_STRING_ERROR_NO_ERROR);
+}
+
+/*!
+ * @brief Reserves space within a string for at least a given amount of characters
+ * @param str destination string
+ * @param length amount of characters the string should be able to hold without
+ * reallocating
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_reserve(s_string_t str, unsigned long int length)
+{
+	if(safe_string_valid(str)) {
+		if(length + 1 > str->s_capacity && !_safe_string_reallocate(str, length + 1)) {
+			safe_string_set_error(_safe_string_modify_error(str));
+			return;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Releases any space held by a string beyond what it's contents require,
+ * moving short strings back into the string structure
+ * @param str destination string
+ * @note Sets the error variable indicating success or failure
+ * @note Strings sharing their buffer with other strings, or mapping a file, are
+ * left untouched
+ */
+void safe_string_shrink_to_fit(s_string_t str)
+{
+	if(safe_string_valid(str)) {
+		if(str->s_capacity > str->s_length && !(str->s_flags & (_S_STRING_FLAG_UNMANAGED | _S_STRING_FLAG_FOREIGN)) && !_safe_string_reallocate(str, str->s_length)) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Ensures a string's buffer isn't shared with any other string
+ * or mapped from a file before it is modified, copying the buffer if it is
+ * @param str destination string
+ * @return Non-zero on success, zero otherwise (literals can never be modified)
+ */
+int _safe_string_unshare(s_string_t str)
+{
+	if(str->s_flags & _S_STRING_FLAG_LITERAL) {
+		return(SAFE_STRING_EMPTY);
+	} else if((str->s_flags & _S_STRING_FLAG_MAPPED) || ((str->s_flags & _S_STRING_FLAG_SHARED) && __atomic_load_n(&_safe_string_shared(str)->s_references, __ATOMIC_ACQUIRE) > 1)) {
+		long int footprint = _safe_string_footprint(str);
+
+		if(!_safe_string_privatize(str, str->s_capacity)) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		_safe_string_stats_live(0, _safe_string_footprint(str) - footprint);
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief (INTERNAL) Creates a string which shares the buffer of another string,
+ * moving the source into a reference counted buffer first if it isn't already
+ * in one
+ * @param str source string (must not be owned by an arena nor map a file)
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Moving the source into a shared buffer modifies it, so the first share
+ * must not race with other uses of the source; once shared, the buffer's count
+ * is updated atomically and strings may be shared from any thread
+ */
+s_string_t _safe_string_share(s_string_t str)
+{
+	s_string_t retn;
+
+	if(!(str->s_flags & _S_STRING_FLAG_SHARED)) {
+		long int footprint = _safe_string_footprint(str);
+		struct _s_string_shared_t *shared = (struct _s_string_shared_t *)_safe_string_malloc(sizeof(struct _s_string_shared_t) + str->s_length);
+
+		if(!shared) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		shared->s_references = 1;
+		memcpy(shared->s_data, str->s_string, str->s_length);
+
+		if(!_safe_string_inline(str)) {
+			_safe_string_buffer_release(str);
+		}
+
+		str->s_string = shared->s_data;
+		str->s_capacity = str->s_length;
+		str->s_flags |= _S_STRING_FLAG_SHARED;
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_SHARE, sizeof(struct _s_string_shared_t) + str->s_length);
+		_safe_string_stats_live(0, sizeof(struct _s_string_shared_t) + str->s_length + _safe_string_footprint(str) - footprint);
+		_safe_string_stats_copy(str->s_length);
+	}
+
+	if(!(retn = _safe_string_cache_allocate_header())) {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	}
+
+	__atomic_add_fetch(&_safe_string_shared(str)->s_references, 1, __ATOMIC_RELAXED);
+
+	memset(retn, 0, sizeof(_s_string_t));
+	retn->s_string = str->s_string;
+	retn->s_length = str->s_length;
+	retn->s_capacity = str->s_capacity;
+	retn->s_flags = _S_STRING_FLAG_SHARED;
+
+	_safe_string_stats_allocate(SAFE_STRING_STATS_SHARE, _safe_string_footprint(retn));
+	_safe_string_stats_live(1, _safe_string_footprint(retn));
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	return(retn);
+}
+
+/*!
+ * @brief (INTERNAL) Empties a string, releasing any buffer it holds outside of
+ * it's structure
+ * @param str destination string
+ */
+static void _safe_string_clear(s_string_t str)
+{
+	if(str->s_flags & _S_STRING_FLAG_UNMANAGED) {
+		; /* the buffer is released along with the arena, or by the caller */
+	} else {
+		long int footprint = _safe_string_footprint(str);
+
+		if(str->s_flags & _S_STRING_FLAG_FOREIGN) {
+			_safe_string_foreign_release(str);
+			str->s_string = str->s_inline;
+			str->s_capacity = SAFE_STRING_INLINE_SIZE;
+		} else if(!_safe_string_inline(str)) {
+			_safe_string_buffer_release(str);
+			str->s_string = str->s_inline;
+			str->s_capacity = SAFE_STRING_INLINE_SIZE;
+		}
+
+		_safe_string_stats_live(0, _safe_string_footprint(str) - footprint);
+	}
+
+	str->s_string[0] = '\0';
+	str->s_length = 1;
+}
+
+/*!
+ * @brief (INTERNAL) Moves the contents of a string held within it's structure
+ * to the heap if they exceed the default embedded buffer, so they fit within
+ * any other structure
+ * @param str destination string (must not be owned by an arena)
+ * @return Non-zero on success, zero otherwise
+ */
+static int _safe_string_evict(s_string_t str)
+{
+	if(_safe_string_inline(str) && str->s_length > SAFE_STRING_INLINE_SIZE) {
+		return(_safe_string_reallocate(str, str->s_capacity + 1)); /* beyond the embedded buffer, forcing the move */
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief Creates a string which takes ownership of an existing buffer, without
+ * copying it
+ * @param buf buffer to adopt (allocated through the library's allocator, see
+ * safe_string_set_allocator)
+ * @param length amount of characters within the buffer
+ * @param capacity size of the buffer (must be greater than the length, the
+ * terminator is written after the last character)
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the buffer remains owned by the caller
+ */
+s_string_t safe_string_adopt(char *buf, unsigned long int length, unsigned long int capacity)
+{
+	if(buf) {
+		if(length < capacity && capacity <= SAFE_STRING_SIZE_MAX) {
+			s_string_t rstring = _safe_string_cache_allocate_header();
+
+			if(!rstring) {
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return(SAFE_STRING_INVALID);
+			}
+
+			memset(rstring, 0, sizeof(_s_string_t));
+			buf[length] = '\0';
+
+			rstring->s_string = buf;
+			rstring->s_length = length + 1;
+			rstring->s_capacity = capacity;
+
+			_safe_string_stats_allocate(SAFE_STRING_STATS_NEW, sizeof(_s_string_t) + SAFE_STRING_INLINE_SIZE);
+			_safe_string_stats_live(1, _safe_string_footprint(rstring));
+
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(rstring);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Deletes a string, handing it's buffer back to the caller
+ * @param str source string
+ * @param length stores the amount of characters within the buffer (may be
+ * SAFE_STRING_INVALID)
+ * @return The terminated buffer, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The buffer is handed out without copying unless it is held within the
+ * structure, shared with another string, mapped or owned by an arena; either
+ * way it must be freed with safe_string_free
+ */
+char *safe_string_release(s_string_t str, unsigned long int *length)
+{
+	if(safe_string_valid(str)) {
+		unsigned long int count = str->s_length - 1;
+		char *retn = str->s_string;
+
+		if((str->s_flags & (_S_STRING_FLAG_UNMANAGED | _S_STRING_FLAG_BUFFER)) || _safe_string_inline(str)) {
+			if(!(retn = (char *)_safe_string_malloc(str->s_length * sizeof(char)))) {
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return(SAFE_STRING_INVALID);
+			}
+
+			memcpy(retn, str->s_string, str->s_length); /* includes the terminator */
+			_safe_string_stats_copy(str->s_length);
+			safe_string_delete(str);
+		} else {
+			_safe_string_stats_live(-1, -_safe_string_footprint(str));
+			_safe_string_cache_release_header(str);
+		}
+
+		if(length) {
+			*length = count;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Moves the contents of one string into another, leaving the source empty
+ * @param str1 destination string
+ * @param str2 source string
+ * @note Sets the error variable indicating success or failure
+ * @note The buffer changes hands without copying; contents are only copied
+ * when held within the source's structure or when either string is owned by
+ * an arena
+ */
+void safe_string_move(s_string_t str1, s_string_t str2)
+{
+	if(safe_string_valid(str1) && safe_string_valid(str2)) {
+		if(str1 == str2) {
+			; /* nothing to move */
+		} else if((str1->s_flags | str2->s_flags) & _S_STRING_FLAG_LITERAL) {
+			safe_string_set_error(SAFE_STRING_ERROR_READ_ONLY);
+			return;
+		} else if((str1->s_flags | str2->s_flags) & _S_STRING_FLAG_UNMANAGED) {
+			if(!_safe_string_grow(str1, str2->s_length)) {
+				return; /* carry the error value */
+			}
+
+			memcpy(str1->s_string, str2->s_string, str2->s_length);
+			_safe_string_stats_copy(str2->s_length);
+			str1->s_length = str2->s_length;
+			_safe_string_clear(str2);
+		} else {
+			long int footprint = 0;
+
+			if(!_safe_string_evict(str2)) {
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return;
+			}
+
+			_safe_string_clear(str1);
+			footprint = _safe_string_footprint(str1) + _safe_string_footprint(str2);
+
+			if(_safe_string_inline(str2)) {
+				memcpy(str1->s_string, str2->s_string, str2->s_length); /* fits within any structure */
+				_safe_string_stats_copy(str2->s_length);
+			} else {
+				str1->s_string = str2->s_string;
+				str1->s_capacity = str2->s_capacity;
+				str1->s_flags |= str2->s_flags & _S_STRING_FLAG_BUFFER;
+				str2->s_flags &= ~_S_STRING_FLAG_BUFFER;
+				str2->s_string = str2->s_inline;
+				str2->s_capacity = SAFE_STRING_INLINE_SIZE;
+			}
+
+			str1->s_length = str2->s_length;
+			str2->s_string[0] = '\0';
+			str2->s_length = 1;
+
+			_safe_string_stats_live(0, _safe_string_footprint(str1) + _safe_string_footprint(str2) - footprint);
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Exchanges the contents of two strings
+ * @param str1 first string
+ * @param str2 second string
+ * @note Sets the error variable indicating success or failure
+ * @note Buffers change hands without copying; contents are only copied when
+ * held within a structure or when either string is owned by an arena
+ */
+void safe_string_swap(s_string_t str1, s_string_t str2)
+{
+	if(safe_string_valid(str1) && safe_string_valid(str2)) {
+		if(str1 == str2) {
+			; /* nothing to exchange */
+		} else if((str1->s_flags | str2->s_flags) & _S_STRING_FLAG_LITERAL) {
+			safe_string_set_error(SAFE_STRING_ERROR_READ_ONLY);
+			return;
+		} else if((str1->s_flags | str2->s_flags) & _S_STRING_FLAG_UNMANAGED) {
+			unsigned long int length = str1->s_length;
+			char *temp = SAFE_STRING_INVALID;
+
+			if(!_safe_string_grow(str1, str2->s_length) || !_safe_string_grow(str2, str1->s_length)) {
+				return; /* carry the error value */
+			}
+
+			if(!(temp = (char *)_safe_string_malloc(length * sizeof(char)))) {
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return;
+			}
+
+			memcpy(temp, str1->s_string, length);
+			memcpy(str1->s_string, str2->s_string, str2->s_length);
+			memcpy(str2->s_string, temp, length);
+			_safe_string_stats_copy(length * 2 + str2->s_length);
+			_safe_string_free(temp);
+
+			str1->s_length = str2->s_length;
+			str2->s_length = length;
+		} else {
+			char temp[SAFE_STRING_INLINE_SIZE];
+			unsigned long int length = str1->s_length;
+			long int footprint = 0;
+
+			if(!_safe_string_evict(str1) || !_safe_string_evict(str2)) {
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return;
+			}
+
+			footprint = _safe_string_footprint(str1) + _safe_string_footprint(str2);
+
+			if(_safe_string_inline(str1) && _safe_string_inline(str2)) {
+				memcpy(temp, str1->s_string, str1->s_length); /* fits within any structure */
+				memcpy(str1->s_string, str2->s_string, str2->s_length);
+				memcpy(str2->s_string, temp, length);
+				_safe_string_stats_copy(length * 2 + str2->s_length);
+			} else if(_safe_string_inline(str1) || _safe_string_inline(str2)) {
+				s_string_t embedded = _safe_string_inline(str1) ? str1 : str2, heap = (embedded == str1) ? str2 : str1;
+
+				memcpy(temp, embedded->s_string, embedded->s_length); /* fits within any structure */
+				embedded->s_string = heap->s_string;
+				embedded->s_capacity = heap->s_capacity;
+				embedded->s_flags |= heap->s_flags & _S_STRING_FLAG_BUFFER;
+				heap->s_flags &= ~_S_STRING_FLAG_BUFFER;
+				heap->s_string = heap->s_inline;
+				heap->s_capacity = SAFE_STRING_INLINE_SIZE;
+				memcpy(heap->s_string, temp, embedded->s_length);
+				_safe_string_stats_copy(embedded->s_length * 2);
+			} else {
+				char *string = str1->s_string;
+				unsigned long int capacity = str1->s_capacity;
+				unsigned int buffer = str1->s_flags & _S_STRING_FLAG_BUFFER;
+
+				str1->s_string = str2->s_string;
+				str1->s_capacity = str2->s_capacity;
+				str1->s_flags = (str1->s_flags & ~_S_STRING_FLAG_BUFFER) | (str2->s_flags & _S_STRING_FLAG_BUFFER);
+				str2->s_string = string;
+				str2->s_capacity = capacity;
+				str2->s_flags = (str2->s_flags & ~_S_STRING_FLAG_BUFFER) | buffer;
+			}
+
+			str1->s_length = str2->s_length;
+			str2->s_length = length;
+
+			_safe_string_stats_live(0, _safe_string_footprint(str1) + _safe_string_footprint(str2) - footprint);
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Creates an empty string within storage provided by the caller, which
+ * never grows beyond that storage
+ * @param storage storage to hold the string structure and it's contents
+ * (suitably aligned for a string structure, see SAFE_STRING_FIXED_STORAGE)
+ * @param size size of the storage (at least the size of a string structure plus
+ * SAFE_STRING_INLINE_SIZE)
+ * @return The string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Operations which would need more room than the storage holds fail with
+ * SAFE_STRING_ERROR_CAPACITY; safe_string_delete has no effect upon the string
+ */
+s_string_t safe_string_fixed(void *storage, unsigned long int size)
+{
+	if(storage) {
+		if(size >= sizeof(_s_string_t) + SAFE_STRING_INLINE_SIZE) {
+			s_string_t rstring = (s_string_t)storage;
+
+			rstring->s_string = rstring->s_inline;
+			rstring->s_string[0] = '\0';
+			rstring->s_length = 1;
+			rstring->s_capacity = MIN(size - sizeof(_s_string_t), SAFE_STRING_SIZE_MAX);
+			rstring->s_flags = _S_STRING_FLAG_FIXED;
+
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(rstring);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Wraps a C string in a read-only string structure provided
+ * by the caller, so it can be passed where a string is expected without copying
+ * @param storage structure to hold the string (usually on the caller's stack)
+ * @param str source C string (must outlive the structure, if NULL then the empty
+ * string is used, as safe_string_new does)
+ * @return The string, or SAFE_STRING_INVALID if the C string is too long
+ */
+s_string_t _safe_string_wrap(_s_string_t *storage, const char *str)
+{
+	unsigned long int length = 0;
+
+	if(!str) {
+		str = "";
+	}
+
+	if((length = strlen(str) + 1) <= SAFE_STRING_SIZE_MAX) {
+		storage->s_string = (char *)str;
+		storage->s_length = length;
+		storage->s_capacity = storage->s_length;
+		storage->s_flags = _S_STRING_FLAG_LITERAL;
+		return(storage);
+	} else {
+		return(SAFE_STRING_INVALID);
+	}
+}
@@ -34,6 +34,23 @@
 #define _SAFE_STRING_UNIVERSAL_ALLOCATE_H_
 
 #include "types/types.h"
+#include "universal/error.h"
+
+/*!
+ * @brief Macro to declare storage for a fixed capacity string, as a variable or
+ * a structure member (see safe_string_fixed)
+ * @param N amount of characters the string can hold at least
+ */
+#define SAFE_STRING_FIXED_STORAGE(N) union { _s_string_t f_string; char f_storage[sizeof(_s_string_t) + (((N) + 1 > SAFE_STRING_INLINE_SIZE) ? (N) + 1 : SAFE_STRING_INLINE_SIZE)]; }
+
+/*!
+ * @brief Macro to declare a fixed capacity string backed by storage within the
+ * enclosing block, e.g. on the stack; it never allocates, operations which need
+ * more room fail with SAFE_STRING_ERROR_CAPACITY
+ * @param name name of the string variable
+ * @param N amount of characters the string can hold at least
+ */
+#define SAFE_STRING_FIXED(name, N) SAFE_STRING_FIXED_STORAGE(N) name##_storage; s_string_t name = safe_string_fixed(&name##_storage, sizeof(name##_storage))
 
 /*!
  * @brief Allocates a new string with a given value
@@ -41,9 +58,105 @@
  * @return The newly created string, or an invalid string
  * if there was an error
  * @note Sets the error variable indicating success or failure
+ * @note Strings shorter than SAFE_STRING_INLINE_SIZE are stored within the
+ * string structure, requiring only a single allocation
  */
 extern s_string_t safe_string_new(const char *);
 
+/*!
+ * @brief Allocates a new string with a given value, storing the structure and
+ * the contents in a single block
+ * @param str value to assign the string
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Intended for strings which are not grown afterwards; growing such a
+ * string moves it's contents into a separate buffer
+ */
+extern s_string_t safe_string_new_embedded(const char *);
+
+/*!
+ * @brief (INTERNAL) Allocates a string of a given length with the structure and
+ * the buffer in a single block; the contents are left for the caller to fill in,
+ * followed by a terminator
+ * @param length amount of characters the string holds
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t _safe_string_allocate(unsigned long int);
+
+/*!
+ * @brief Allocates a new string with a given value from an arena
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param str value to assign the string
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The string is released along with the arena, safe_string_delete has
+ * no effect upon it
+ */
+extern s_string_t safe_string_new_in(safe_string_arena_t, const char *);
+
+/*!
+ * @brief Allocates a new string holding a given amount of characters from an
+ * arena, with the structure and the buffer in a single block
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_string_new_length_in(safe_string_arena_t, const void *, unsigned long int);
+
+/*!
+ * @brief Allocates a new string holding a given amount of characters, with the
+ * structure and the buffer in a single block
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @return The newly created string, or an invalid string
+ * if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_string_new_length(const void *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates a string of a given length with the structure and
+ * the buffer in a single block; the contents are left for the caller to fill in,
+ * followed by a terminator
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param length amount of characters the string holds
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t _safe_string_allocate_in(safe_string_arena_t, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates a string holding a copy of a range of characters,
+ * with the structure and the buffer in a single block
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param data characters to copy (may contain NULs)
+ * @param length amount of characters to copy
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t _safe_string_allocate_copy_in(safe_string_arena_t, const void *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates an array of strings
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the array
+ * is allocated from the heap)
+ * @param count amount of elements within the array
+ * @return The newly created (zeroed) array, or SAFE_STRING_INVALID if there
+ * was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_strings_t _safe_string_array_allocate_in(safe_string_arena_t, unsigned long int);
+
 /*!
  * @brief Deletes a given string
  * @param str source string
@@ -56,7 +169,150 @@ extern void safe_string_delete(s_string_t);
  * @param strs source array of strings
  * @param count number of elements in the array
  * @note Sets the error variable indicating success or failure
+ * @note Arrays allocated from an arena must not be passed to this function,
+ * they are released along with the arena
  */
 extern void safe_string_array_delete(s_strings_t strs, unsigned long int count);
 
+/*!
+ * @brief (INTERNAL) Determines why a string couldn't be modified
+ * @param str destination string
+ * @return SAFE_STRING_ERROR_READ_ONLY for literals, SAFE_STRING_ERROR_CAPACITY
+ * for fixed capacity strings and SAFE_STRING_ERROR_MEM_ALLOC otherwise
+ */
+extern s_string_error_t _safe_string_modify_error(s_string_t);
+
+/*!
+ * @brief (INTERNAL) Ensures a string's buffer can hold at least a given amount
+ * of characters (including the terminator); the buffer at least doubles in size
+ * when it has to be reallocated, making repeated appends amortized O(1)
+ * @param str destination string
+ * @param size minimum size of the buffer
+ * @return Error code indicating success or failure
+ * @note Does not touch the error variable
+ */
+extern s_string_error_t _safe_string_grow_r(s_string_t, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Ensures a string's buffer can hold at least a given amount
+ * of characters (including the terminator); the buffer at least doubles in size
+ * when it has to be reallocated, making repeated appends amortized O(1)
+ * @param str destination string
+ * @param size minimum size of the buffer
+ * @return Non-zero on success, zero otherwise
+ * @note Sets the error variable indicating success or failure
+ */
+extern int _safe_string_grow(s_string_t, unsigned long int);
+
+/*!
+ * @brief Reserves space within a string for at least a given amount of characters
+ * @param str destination string
+ * @param length amount of characters the string should be able to hold without
+ * reallocating
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_reserve(s_string_t, unsigned long int);
+
+/*!
+ * @brief Releases any space held by a string beyond what it's contents require,
+ * moving short strings back into the string structure
+ * @param str destination string
+ * @note Sets the error variable indicating success or failure
+ * @note Strings sharing their buffer with other strings are left untouched
+ */
+extern void safe_string_shrink_to_fit(s_string_t);
+
+/*!
+ * @brief (INTERNAL) Ensures a string's buffer isn't shared with any other string
+ * or mapped from a file before it is modified, copying the buffer if it is
+ * @param str destination string
+ * @return Non-zero on success, zero otherwise (literals can never be modified)
+ */
+extern int _safe_string_unshare(s_string_t);
+
+/*!
+ * @brief (INTERNAL) Creates a string which shares the buffer of another string,
+ * moving the source into a reference counted buffer first if it isn't already
+ * in one
+ * @param str source string (must not be owned by an arena nor map a file)
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Moving the source into a shared buffer modifies it, so the first share
+ * must not race with other uses of the source; once shared, the buffer's count
+ * is updated atomically and strings may be shared from any thread
+ */
+extern s_string_t _safe_string_share(s_string_t);
+
+/*!
+ * @brief Creates a string which takes ownership of an existing buffer, without
+ * copying it
+ * @param buf buffer to adopt (allocated through the library's allocator, see
+ * safe_string_set_allocator)
+ * @param length amount of characters within the buffer
+ * @param capacity size of the buffer (must be greater than the length, the
+ * terminator is written after the last character)
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the buffer remains owned by the caller
+ */
+extern s_string_t safe_string_adopt(char *, unsigned long int, unsigned long int);
+
+/*!
+ * @brief Deletes a string, handing it's buffer back to the caller
+ * @param str source string
+ * @param length stores the amount of characters within the buffer (may be
+ * SAFE_STRING_INVALID)
+ * @return The terminated buffer, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The buffer is handed out without copying unless it is held within the
+ * structure, shared with another string, mapped or owned by an arena; either
+ * way it must be freed with safe_string_free
+ */
+extern char *safe_string_release(s_string_t, unsigned long int *);
+
+/*!
+ * @brief Moves the contents of one string into another, leaving the source empty
+ * @param str1 destination string
+ * @param str2 source string
+ * @note Sets the error variable indicating success or failure
+ * @note The buffer changes hands without copying; contents are only copied
+ * when held within the source's structure or when either string is owned by
+ * an arena
+ */
+extern void safe_string_move(s_string_t, s_string_t);
+
+/*!
+ * @brief Exchanges the contents of two strings
+ * @param str1 first string
+ * @param str2 second string
+ * @note Sets the error variable indicating success or failure
+ * @note Buffers change hands without copying; contents are only copied when
+ * held within a structure or when either string is owned by an arena
+ */
+extern void safe_string_swap(s_string_t, s_string_t);
+
+/*!
+ * @brief Creates an empty string within storage provided by the caller, which
+ * never grows beyond that storage
+ * @param storage storage to hold the string structure and it's contents
+ * (suitably aligned for a string structure, see SAFE_STRING_FIXED_STORAGE)
+ * @param size size of the storage (at least the size of a string structure plus
+ * SAFE_STRING_INLINE_SIZE)
+ * @return The string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Operations which would need more room than the storage holds fail with
+ * SAFE_STRING_ERROR_CAPACITY; safe_string_delete has no effect upon the string
+ */
+extern s_string_t safe_string_fixed(void *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Wraps a C string in a read-only string structure provided
+ * by the caller, so it can be passed where a string is expected without copying
+ * @param storage structure to hold the string (usually on the caller's stack)
+ * @param str source C string (must outlive the structure, if NULL then the empty
+ * string is used, as safe_string_new does)
+ * @return The string, or SAFE_STRING_INVALID if the C string is too long
+ */
+extern s_string_t _safe_string_wrap(_s_string_t *, const char *);
+
 #endif
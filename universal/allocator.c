@@ -0,0 +1,184 @@
+/*!
+ * @file universal/allocator.c
+ * @brief Pluggable memory allocator used by every allocation within the library
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h> /* malloc, realloc, free */
+#include <string.h> /* memset */
+#include "types/types.h"
+#include "universal.h"
+
+/*!
+ * @brief (INTERNAL) Default allocation callback
+ * @param user unused
+ * @param size amount of bytes to allocate
+ * @return The allocated memory, or SAFE_STRING_INVALID on failure
+ */
+static void *_safe_string_default_allocate(void *user, unsigned long int size)
+{
+	(void)user;
+	return(malloc(size));
+}
+
+/*!
+ * @brief (INTERNAL) Default reallocation callback
+ * @param user unused
+ * @param ptr memory to resize
+ * @param size new size of the memory
+ * @return The resized memory, or SAFE_STRING_INVALID on failure
+ */
+static void *_safe_string_default_reallocate(void *user, void *ptr, unsigned long int size)
+{
+	(void)user;
+	return(realloc(ptr, size));
+}
+
+/*!
+ * @brief (INTERNAL) Default release callback
+ * @param user unused
+ * @param ptr memory to release
+ */
+static void _safe_string_default_release(void *user, void *ptr)
+{
+	(void)user;
+	free(ptr);
+}
+
+static safe_string_allocator_t _s_allocator = { _safe_string_default_allocate, _safe_string_default_reallocate, _safe_string_default_release, SAFE_STRING_INVALID }; /*!< (INTERNAL) Allocator used by the library */
+
+/*!
+ * @brief Sets the allocator used for every allocation made by the library
+ * @param allocator the callbacks to use (if SAFE_STRING_INVALID then the
+ * standard library's allocator is restored)
+ * @note Sets the error variable indicating success or failure
+ * @note Must be called before any memory is allocated by the library and must
+ * not be changed afterwards
+ */
+void safe_string_set_allocator(const safe_string_allocator_t *allocator)
+{
+	if(!allocator) {
+		_s_allocator.allocate = _safe_string_default_allocate;
+		_s_allocator.reallocate = _safe_string_default_reallocate;
+		_s_allocator.release = _safe_string_default_release;
+		_s_allocator.user = SAFE_STRING_INVALID;
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else if(allocator->allocate && allocator->reallocate && allocator->release) {
+		_s_allocator = *allocator;
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Gets the allocator used for every allocation made by the library
+ * @return The callbacks in use
+ */
+safe_string_allocator_t safe_string_get_allocator(void)
+{
+	return(_s_allocator);
+}
+
+/*!
+ * @brief Frees memory returned by the library which isn't a string or an array
+ * of strings (such as the results of safe_string_access_characters_duplicate and
+ * safe_string_count_chars)
+ * @param ptr memory to release
+ */
+void safe_string_free(void *ptr)
+{
+	if(ptr) {
+		_s_allocator.release(_s_allocator.user, ptr);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Allocates memory through the library's allocator
+ * @param size amount of bytes to allocate
+ * @return The allocated memory, or SAFE_STRING_INVALID on failure
+ */
+void *_safe_string_malloc(unsigned long int size)
+{
+	return(_s_allocator.allocate(_s_allocator.user, size));
+}
+
+/*!
+ * @brief (INTERNAL) Allocates zeroed memory for an array through the library's
+ * allocator
+ * @param count amount of elements
+ * @param size size of each element
+ * @return The allocated memory, or SAFE_STRING_INVALID on failure
+ */
+void *_safe_string_calloc(unsigned long int count, unsigned long int size)
+{
+	void *retn = SAFE_STRING_INVALID;
+
+	if(!size || count <= (unsigned long int)-1 / size) {
+		retn = _s_allocator.allocate(_s_allocator.user, count * size);
+
+		if(retn) {
+			memset(retn, 0, count * size);
+		}
+	}
+
+	return(retn);
+}
+
+/*!
+ * @brief (INTERNAL) Resizes memory through the library's allocator
+ * @param ptr memory to resize (if SAFE_STRING_INVALID then memory is allocated)
+ * @param size new size of the memory
+ * @return The resized memory, or SAFE_STRING_INVALID on failure (in which case
+ * the original memory is left untouched)
+ */
+void *_safe_string_realloc(void *ptr, unsigned long int size)
+{
+	return(ptr ? _s_allocator.reallocate(_s_allocator.user, ptr, size) : _s_allocator.allocate(_s_allocator.user, size));
+}
+
+/*!
+ * @brief (INTERNAL) Releases memory through the library's allocator
+ * @param ptr memory to release
+ */
+void _safe_string_free(void *ptr)
+{
+	if(ptr) {
+		_s_allocator.release(_s_allocator.user, ptr);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Checks if the standard library's allocator is in use
+ * @return Non-zero if no allocator was set, zero otherwise
+ */
+int _safe_string_allocator_default(void)
+{
+	return(_s_allocator.allocate == _safe_string_default_allocate);
+}
@@ -0,0 +1,107 @@
+/*!
+ * @file universal/allocator.h
+ * @brief Header file for the pluggable memory allocator
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_ALLOCATOR_H_
+#define _SAFE_STRING_UNIVERSAL_ALLOCATOR_H_
+
+/*!
+ * @brief Type definition for the callbacks the library allocates memory through
+ */
+typedef struct {
+	void *(*allocate)(void *, unsigned long int); /*!< Allocates memory (user pointer, size) */
+	void *(*reallocate)(void *, void *, unsigned long int); /*!< Resizes memory (user pointer, memory, new size) */
+	void (*release)(void *, void *); /*!< Releases memory (user pointer, memory) */
+	void *user; /*!< Pointer passed to each of the callbacks */
+} safe_string_allocator_t;
+
+/*!
+ * @brief Sets the allocator used for every allocation made by the library
+ * @param allocator the callbacks to use (if SAFE_STRING_INVALID then the
+ * standard library's allocator is restored)
+ * @note Sets the error variable indicating success or failure
+ * @note Must be called before any memory is allocated by the library and must
+ * not be changed afterwards
+ */
+extern void safe_string_set_allocator(const safe_string_allocator_t *);
+
+/*!
+ * @brief Gets the allocator used for every allocation made by the library
+ * @return The callbacks in use
+ */
+extern safe_string_allocator_t safe_string_get_allocator(void);
+
+/*!
+ * @brief Frees memory returned by the library which isn't a string or an array
+ * of strings (such as the results of safe_string_access_characters_duplicate and
+ * safe_string_count_chars)
+ * @param ptr memory to release
+ */
+extern void safe_string_free(void *);
+
+/*!
+ * @brief (INTERNAL) Allocates memory through the library's allocator
+ * @param size amount of bytes to allocate
+ * @return The allocated memory, or SAFE_STRING_INVALID on failure
+ */
+extern void *_safe_string_malloc(unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates zeroed memory for an array through the library's
+ * allocator
+ * @param count amount of elements
+ * @param size size of each element
+ * @return The allocated memory, or SAFE_STRING_INVALID on failure
+ */
+extern void *_safe_string_calloc(unsigned long int, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Resizes memory through the library's allocator
+ * @param ptr memory to resize (if SAFE_STRING_INVALID then memory is allocated)
+ * @param size new size of the memory
+ * @return The resized memory, or SAFE_STRING_INVALID on failure (in which case
+ * the original memory is left untouched)
+ */
+extern void *_safe_string_realloc(void *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Releases memory through the library's allocator
+ * @param ptr memory to release
+ */
+extern void _safe_string_free(void *);
+
+/*!
+ * @brief (INTERNAL) Checks if the standard library's allocator is in use
+ * @return Non-zero if no allocator was set, zero otherwise
+ */
+extern int _safe_string_allocator_default(void);
+
+#endif
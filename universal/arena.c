@@ -0,0 +1,181 @@
+/*!
+ * @file universal/arena.c
+ * @brief Arena allocation of request-scoped strings
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memset */
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+#define _S_ARENA_ALIGNMENT sizeof(void *) /*!< (INTERNAL) Alignment of every allocation handed out by an arena */
+#define _S_ARENA_BLOCK_SIZE 4096 /*!< (INTERNAL) Default size of an arena block */
+
+/*!
+ * @brief (INTERNAL) Allocates a new arena block
+ * @param size amount of usable bytes within the block
+ * @return The newly created block, or SAFE_STRING_INVALID on error
+ */
+static struct _s_string_arena_block_t *_safe_string_arena_block_new(unsigned long int size)
+{
+	struct _s_string_arena_block_t *block = (struct _s_string_arena_block_t *)_safe_string_malloc(sizeof(struct _s_string_arena_block_t) + size);
+
+	if(block) {
+		block->next = SAFE_STRING_INVALID;
+		block->size = size;
+		block->used = 0;
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_ARENA, sizeof(struct _s_string_arena_block_t) + size);
+	}
+
+	return(block);
+}
+
+/*!
+ * @brief Creates a new arena
+ * @param block_size size of the blocks the arena allocates from (if 0 then a
+ * default size is used)
+ * @return The newly created arena, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+safe_string_arena_t safe_string_arena_new(unsigned long int block_size)
+{
+	safe_string_arena_t arena = (safe_string_arena_t)_safe_string_malloc(sizeof(struct _s_string_arena_t));
+
+	if(arena) {
+		arena->blocks = SAFE_STRING_INVALID;
+		arena->block_size = block_size ? block_size : _S_ARENA_BLOCK_SIZE;
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_ARENA, sizeof(struct _s_string_arena_t));
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(arena);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Allocates zeroed memory from an arena
+ * @param arena arena to allocate from
+ * @param size amount of bytes to allocate
+ * @return The allocated memory, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+void *_safe_string_arena_allocate(safe_string_arena_t arena, unsigned long int size)
+{
+	if(arena) {
+		struct _s_string_arena_block_t *block = arena->blocks;
+		void *retn;
+
+		size = (size + _S_ARENA_ALIGNMENT - 1) & ~(_S_ARENA_ALIGNMENT - 1);
+
+		if(!block || block->size - block->used < size) {
+			block = _safe_string_arena_block_new(MAX(size, arena->block_size));
+
+			if(!block) {
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return(SAFE_STRING_INVALID);
+			}
+
+			if(arena->blocks && size > arena->block_size) {
+				/* oversized blocks are used up straight away, so keep the current block in front */
+				block->next = arena->blocks->next;
+				arena->blocks->next = block;
+			} else {
+				block->next = arena->blocks;
+				arena->blocks = block;
+			}
+		}
+
+		retn = block->data + block->used;
+		block->used += size;
+
+		memset(retn, 0, size);
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Releases every string and array allocated from an arena at once, the
+ * arena keeps one block of the standard size to allocate from afterwards
+ * (oversized blocks are always released)
+ * @param arena arena to reset
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_arena_reset(safe_string_arena_t arena)
+{
+	if(arena) {
+		struct _s_string_arena_block_t *block = arena->blocks, *next, *kept = SAFE_STRING_INVALID;
+
+		while(block) {
+			next = block->next;
+
+			if(!kept && block->size <= arena->block_size) {
+				kept = block;
+			} else {
+				_safe_string_free(block);
+			}
+
+			block = next;
+		}
+
+		if(kept) {
+			kept->next = SAFE_STRING_INVALID;
+			kept->used = 0;
+		}
+
+		arena->blocks = kept;
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Deletes an arena along with every string and array allocated from it
+ * @param arena arena to delete
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_arena_delete(safe_string_arena_t arena)
+{
+	if(arena) {
+		safe_string_arena_reset(arena);
+		_safe_string_free(arena->blocks);
+		_safe_string_free(arena);
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+}
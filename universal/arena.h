@@ -0,0 +1,71 @@
+/*!
+ * @file universal/arena.h
+ * @brief Header file for arena allocation of request-scoped strings
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_ARENA_H_
+#define _SAFE_STRING_UNIVERSAL_ARENA_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief Creates a new arena
+ * @param block_size size of the blocks the arena allocates from (if 0 then a
+ * default size is used)
+ * @return The newly created arena, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern safe_string_arena_t safe_string_arena_new(unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates zeroed memory from an arena
+ * @param arena arena to allocate from
+ * @param size amount of bytes to allocate
+ * @return The allocated memory, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern void *_safe_string_arena_allocate(safe_string_arena_t, unsigned long int);
+
+/*!
+ * @brief Releases every string and array allocated from an arena at once, the
+ * arena keeps it's current block to allocate from afterwards
+ * @param arena arena to reset
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_arena_reset(safe_string_arena_t);
+
+/*!
+ * @brief Deletes an arena along with every string and array allocated from it
+ * @param arena arena to delete
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_arena_delete(safe_string_arena_t);
+
+#endif
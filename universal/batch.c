@@ -0,0 +1,116 @@
+/*!
+ * @file universal/batch.c
+ * @brief Strings allocated in batches
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* strlen */
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+#define _S_BATCH_BLOCK_SIZE (1UL << 24) /*!< (INTERNAL) Largest block a batch allocates from */
+
+/*!
+ * @brief (INTERNAL) Macro to estimate the bytes a string of a given length takes
+ * within a batch (the arena, structure and contents, plus alignment)
+ * @param l length of the string
+ * @return The estimated size
+ */
+#define _S_BATCH_ENTRY_SIZE(l) (sizeof(safe_string_arena_t) + sizeof(_s_string_t) + MAX((l) + 1, SAFE_STRING_INLINE_SIZE) + sizeof(void *))
+
+/*!
+ * @brief Allocates an array of strings with given values in a single call, the
+ * array, structures and contents being carved out of a few large blocks
+ * @param strs values to assign the strings (may contain NULs when lengths are given)
+ * @param lengths amount of characters within each value (if SAFE_STRING_INVALID
+ * then each value is terminated)
+ * @param count amount of strings to allocate
+ * @return The newly created array, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The strings may be modified like any other, but safe_string_delete has
+ * no effect upon them; the whole batch is released with safe_string_batch_delete
+ */
+s_strings_t safe_string_new_batch(const char **strs, const unsigned long int *lengths, unsigned long int count)
+{
+	if(strs || !count) {
+		unsigned long int i = 0, size = sizeof(safe_string_arena_t) + count * sizeof(s_string_t);
+		safe_string_arena_t arena, *head;
+		s_strings_t retn;
+
+		for(i = 0; i < count; i++) {
+			size += _S_BATCH_ENTRY_SIZE(lengths ? lengths[i] : (strs[i] ? strlen(strs[i]) : 0));
+		}
+
+		if(!(arena = safe_string_arena_new(MIN(size, _S_BATCH_BLOCK_SIZE)))) {
+			return(SAFE_STRING_INVALID); /* use the error code from safe_string_arena_new */
+		}
+
+		/* the arena is stored immediately before the array, as it is for arena strings */
+		if(!(head = (safe_string_arena_t *)_safe_string_arena_allocate(arena, sizeof(safe_string_arena_t) + count * sizeof(s_string_t)))) {
+			safe_string_arena_delete(arena);
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		head[0] = arena;
+		retn = (s_strings_t)(head + 1);
+
+		for(i = 0; i < count; i++) {
+			if(!(retn[i] = safe_string_new_length_in(arena, strs[i], lengths ? lengths[i] : (strs[i] ? strlen(strs[i]) : 0)))) {
+				s_string_error_t error = safe_string_error_val();
+				safe_string_arena_delete(arena);
+				safe_string_set_error(error);
+				return(SAFE_STRING_INVALID);
+			}
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Deletes an array of strings allocated by safe_string_new_batch, along
+ * with every string within it
+ * @param strs source array of strings
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_batch_delete(s_strings_t strs)
+{
+	if(strs) {
+		safe_string_arena_delete(((safe_string_arena_t *)strs)[-1]);
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	strs = SAFE_STRING_INVALID;
+}
@@ -0,0 +1,60 @@
+/*!
+ * @file universal/batch.h
+ * @brief Header file for strings allocated in batches
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_BATCH_H_
+#define _SAFE_STRING_UNIVERSAL_BATCH_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief Allocates an array of strings with given values in a single call, the
+ * array, structures and contents being carved out of a few large blocks
+ * @param strs values to assign the strings (may contain NULs when lengths are given)
+ * @param lengths amount of characters within each value (if SAFE_STRING_INVALID
+ * then each value is terminated)
+ * @param count amount of strings to allocate
+ * @return The newly created array, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The strings may be modified like any other, but safe_string_delete has
+ * no effect upon them; the whole batch is released with safe_string_batch_delete
+ */
+extern s_strings_t safe_string_new_batch(const char **, const unsigned long int *, unsigned long int);
+
+/*!
+ * @brief Deletes an array of strings allocated by safe_string_new_batch, along
+ * with every string within it
+ * @param strs source array of strings
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_batch_delete(s_strings_t);
+
+#endif
@@ -0,0 +1,252 @@
+/*!
+ * @file universal/cache.c
+ * @brief Per-thread cache of recycled string structures and buffers
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+#define _S_CACHE_CLASSES 4 /*!< (INTERNAL) Amount of buffer size classes cached */
+#define _S_CACHE_CLASS_MINIMUM 32 /*!< (INTERNAL) Size of the smallest class, each class doubles the last */
+#define _S_CACHE_CLASS_MAXIMUM (_S_CACHE_CLASS_MINIMUM << (_S_CACHE_CLASSES - 1)) /*!< (INTERNAL) Size of the largest class */
+#define _S_CACHE_HEADER _S_CACHE_CLASSES /*!< (INTERNAL) Index of the free list holding string structures */
+#define _S_CACHE_HEADER_SIZE (sizeof(_s_string_t) + SAFE_STRING_INLINE_SIZE) /*!< (INTERNAL) Size of a string structure with the default embedded buffer */
+
+static unsigned long int _s_cache_limit = 0; /*!< (INTERNAL) Maximum amount of blocks cached per free list and thread, 0 disables the cache (accessed atomically) */
+static pthread_once_t _s_cache_once = PTHREAD_ONCE_INIT; /*!< (INTERNAL) Creates the key used to release the blocks of exiting threads */
+static pthread_key_t _s_cache_key; /*!< (INTERNAL) Key whose destructor releases a thread's blocks on exit */
+
+/* __thread: stored in TLS (linux) */
+__thread void *_s_cache_blocks[_S_CACHE_CLASSES + 1]; /*!< (INTERNAL) Free lists of cached blocks, linked through their first word (thread safe) */
+__thread unsigned long int _s_cache_counts[_S_CACHE_CLASSES + 1]; /*!< (INTERNAL) Amount of blocks within each free list (thread safe) */
+__thread int _s_cache_registered = 0; /*!< (INTERNAL) Whether the calling thread's blocks are released on exit (thread safe) */
+
+/*!
+ * @brief (INTERNAL) Obtains the maximum amount of blocks cached per free list
+ * @return The limit, 0 if the cache is disabled
+ */
+static inline unsigned long int _safe_string_cache_limit(void)
+{
+	return(__atomic_load_n(&_s_cache_limit, __ATOMIC_RELAXED));
+}
+
+/*!
+ * @brief (INTERNAL) Takes a block from a free list
+ * @param i index of the free list
+ * @return The cached block, or SAFE_STRING_INVALID if the list is empty
+ */
+static inline void *_safe_string_cache_pop(unsigned long int i)
+{
+	void *block = _s_cache_blocks[i];
+
+	if(block) {
+		_s_cache_blocks[i] = *(void **)block;
+		_s_cache_counts[i]--;
+	}
+
+	return(block);
+}
+
+/*!
+ * @brief (INTERNAL) Releases the blocks cached by the calling thread beyond a
+ * given amount per free list
+ * @param limit amount of blocks to keep within each free list
+ */
+static void _safe_string_cache_trim(unsigned long int limit)
+{
+	unsigned long int i = 0;
+
+	for(i = 0; i <= _S_CACHE_HEADER; i++) {
+		while(_s_cache_counts[i] > limit) {
+			_safe_string_free(_safe_string_cache_pop(i));
+		}
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Releases every block cached by an exiting thread
+ * @param data unused
+ */
+static void _safe_string_cache_exit(void *data)
+{
+	(void)data;
+	_safe_string_cache_trim(0);
+	_s_cache_registered = 0; /* registers again if the thread caches a block after this */
+}
+
+/*!
+ * @brief (INTERNAL) Creates the key used to release the blocks of exiting threads
+ */
+static void _safe_string_cache_key(void)
+{
+	pthread_key_create(&_s_cache_key, _safe_string_cache_exit);
+}
+
+/*!
+ * @brief (INTERNAL) Places a block onto a free list if it has room, otherwise
+ * the block is freed
+ * @param i index of the free list
+ * @param block block to cache
+ */
+static inline void _safe_string_cache_push(unsigned long int i, void *block)
+{
+	if(_s_cache_counts[i] < _safe_string_cache_limit()) {
+		if(!_s_cache_registered) {
+			pthread_once(&_s_cache_once, _safe_string_cache_key);
+			pthread_setspecific(_s_cache_key, _s_cache_blocks); /* any non-NULL value, so the destructor runs */
+			_s_cache_registered = !SAFE_STRING_EMPTY;
+		}
+
+		*(void **)block = _s_cache_blocks[i];
+		_s_cache_blocks[i] = block;
+		_s_cache_counts[i]++;
+	} else {
+		_safe_string_free(block);
+	}
+}
+
+/*!
+ * @brief Sets the maximum amount of blocks cached by each thread for every size
+ * class; blocks released beyond this are returned to the system allocator
+ * @param limit the maximum amount of blocks (if 0 then the cache is disabled)
+ * @note Blocks already cached by the calling thread beyond the new limit are released
+ */
+void safe_string_cache_set_limit(unsigned long int limit)
+{
+	__atomic_store_n(&_s_cache_limit, limit, __ATOMIC_RELAXED);
+	_safe_string_cache_trim(limit);
+}
+
+/*!
+ * @brief Releases every block cached by the calling thread
+ * @note The blocks of a thread are also released when it exits
+ */
+void safe_string_cache_flush(void)
+{
+	_safe_string_cache_trim(0);
+}
+
+/*!
+ * @brief (INTERNAL) Rounds a buffer size up to the size class it is cached in
+ * @param size minimum size of the buffer
+ * @return The size of the buffer which should be allocated
+ */
+unsigned long int _safe_string_cache_size(unsigned long int size)
+{
+	if(size <= _S_CACHE_CLASS_MAXIMUM) {
+		unsigned long int class_size = _S_CACHE_CLASS_MINIMUM;
+
+		while(class_size < size) {
+			class_size <<= 1;
+		}
+
+		return(class_size);
+	}
+
+	return(size);
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a buffer, reusing a cached block if one is available
+ * @param size size of the buffer (see _safe_string_cache_size)
+ * @return The allocated buffer (with undefined contents), or SAFE_STRING_INVALID
+ * if there was an error
+ */
+void *_safe_string_cache_allocate(unsigned long int size)
+{
+	if(_safe_string_cache_limit() && size <= _S_CACHE_CLASS_MAXIMUM) {
+		unsigned long int i = 0, class_size = _S_CACHE_CLASS_MINIMUM;
+		void *block;
+
+		while(class_size < size) {
+			class_size <<= 1;
+			i++;
+		}
+
+		if((block = _safe_string_cache_pop(i))) {
+			return(block);
+		}
+
+		return(_safe_string_malloc(class_size)); /* round up so the block can be cached once released */
+	}
+
+	return(_safe_string_malloc(size));
+}
+
+/*!
+ * @brief (INTERNAL) Releases a buffer, caching it if there is room
+ * @param block buffer to release
+ * @param size size of the buffer (it may be larger than the size requested
+ * when it was allocated, never smaller)
+ */
+void _safe_string_cache_release(void *block, unsigned long int size)
+{
+	if(block && _safe_string_cache_limit() && size >= _S_CACHE_CLASS_MINIMUM && size < (_S_CACHE_CLASS_MAXIMUM << 1)) {
+		unsigned long int i = _S_CACHE_CLASSES - 1, class_size = _S_CACHE_CLASS_MAXIMUM;
+
+		while(class_size > size) {
+			class_size >>= 1;
+			i--;
+		}
+
+		_safe_string_cache_push(i, block);
+	} else {
+		_safe_string_free(block);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a string structure with the default embedded buffer,
+ * reusing a cached structure if one is available
+ * @return The allocated structure (with undefined contents), or SAFE_STRING_INVALID
+ * if there was an error
+ */
+s_string_t _safe_string_cache_allocate_header(void)
+{
+	void *block = _safe_string_cache_limit() ? _safe_string_cache_pop(_S_CACHE_HEADER) : SAFE_STRING_INVALID;
+
+	return((s_string_t)(block ? block : _safe_string_malloc(_S_CACHE_HEADER_SIZE)));
+}
+
+/*!
+ * @brief (INTERNAL) Releases a string structure, caching it if there is room
+ * @param str structure to release (every structure embeds at least the default
+ * buffer so any structure may be cached)
+ */
+void _safe_string_cache_release_header(s_string_t str)
+{
+	if(str && _safe_string_cache_limit()) {
+		_safe_string_cache_push(_S_CACHE_HEADER, str);
+	} else {
+		_safe_string_free(str);
+	}
+}
@@ -0,0 +1,90 @@
+/*!
+ * @file universal/cache.h
+ * @brief Header file for the per-thread cache of recycled string structures and buffers
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_CACHE_H_
+#define _SAFE_STRING_UNIVERSAL_CACHE_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief Sets the maximum amount of blocks cached by each thread for every size
+ * class; blocks released beyond this are returned to the system allocator
+ * @param limit the maximum amount of blocks (if 0 then the cache is disabled)
+ * @note Blocks already cached by the calling thread beyond the new limit are released
+ */
+extern void safe_string_cache_set_limit(unsigned long int);
+
+/*!
+ * @brief Releases every block cached by the calling thread
+ * @note The blocks of a thread are also released when it exits
+ */
+extern void safe_string_cache_flush(void);
+
+/*!
+ * @brief (INTERNAL) Rounds a buffer size up to the size class it is cached in
+ * @param size minimum size of the buffer
+ * @return The size of the buffer which should be allocated
+ */
+extern unsigned long int _safe_string_cache_size(unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates a buffer, reusing a cached block if one is available
+ * @param size size of the buffer (see _safe_string_cache_size)
+ * @return The allocated buffer (with undefined contents), or SAFE_STRING_INVALID
+ * if there was an error
+ */
+extern void *_safe_string_cache_allocate(unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Releases a buffer, caching it if there is room
+ * @param block buffer to release
+ * @param size size of the buffer (it may be larger than the size requested
+ * when it was allocated, never smaller)
+ */
+extern void _safe_string_cache_release(void *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates a string structure with the default embedded buffer,
+ * reusing a cached structure if one is available
+ * @return The allocated structure (with undefined contents), or SAFE_STRING_INVALID
+ * if there was an error
+ */
+extern s_string_t _safe_string_cache_allocate_header(void);
+
+/*!
+ * @brief (INTERNAL) Releases a string structure, caching it if there is room
+ * @param str structure to release (every structure embeds at least the default
+ * buffer so any structure may be cached)
+ */
+extern void _safe_string_cache_release_header(s_string_t);
+
+#endif
@@ -43,9 +43,13 @@ typedef enum { \
 	SAFE_STRING_ERROR_NULL_POINTER /*!< A NULL pointer was passed to the function and it couldn't be handled */, \
 	SAFE_STRING_ERROR_INDEX_BOUNDS /*!< An attempt was made to access memory outside of the defined boundaries */, \
 	SAFE_STRING_ERROR_BAD_VALUE /*!< An invalid value was produced/taken */, \
-	SAFE_STRING_ERROR_INVALID_RETURN /*!< The return value isn't valid - assume the function couldn't perform the task - i.e. a value could not be found, etc. */ \
+	SAFE_STRING_ERROR_INVALID_RETURN /*!< The return value isn't valid - assume the function couldn't perform the task - i.e. a value could not be found, etc. */, \
+	SAFE_STRING_ERROR_CAPACITY /*!< The result doesn't fit within a fixed capacity string */, \
+	SAFE_STRING_ERROR_READ_ONLY /*!< An attempt was made to modify a read-only string (a string literal or an interned string) */ \
 } s_string_error_t;
 
+extern __thread s_string_error_t _safe_string_error; /*!< (INTERNAL) error variable (thread safe) */
+
 /*!
  * @brief Sets the error variable
  * @param err value to set the error variable
@@ -0,0 +1,310 @@
+/*!
+ * @file universal/intern.c
+ * @brief Interning table which maps string contents to canonical strings and 32-bit identifiers
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memcpy, memcmp */
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+#define _S_INTERN_SLOTS_INITIAL 16 /*!< (INTERNAL) Initial amount of slots within an interning table (a power of two) */
+#define _S_INTERN_FNV_OFFSET 2166136261u /*!< (INTERNAL) Offset basis of the 32-bit FNV-1a hash */
+#define _S_INTERN_FNV_PRIME 16777619u /*!< (INTERNAL) Prime of the 32-bit FNV-1a hash */
+
+/*!
+ * @brief (INTERNAL) Hashes a range of characters (32-bit FNV-1a)
+ * @param str characters to hash
+ * @param length amount of characters to hash
+ * @return The hash of the characters
+ */
+static uint32_t _safe_string_intern_hash(const char *str, unsigned long int length)
+{
+	uint32_t hash = _S_INTERN_FNV_OFFSET;
+	unsigned long int i = 0;
+
+	for(i = 0; i < length; i++) {
+		hash = (hash ^ (unsigned char)str[i]) * _S_INTERN_FNV_PRIME;
+	}
+
+	return(hash);
+}
+
+/*!
+ * @brief (INTERNAL) Rebuilds the hash table of an interning table with a given
+ * amount of slots
+ * @param table destination table
+ * @param slot_count amount of slots (a power of two, greater than the amount of
+ * strings)
+ * @return Non-zero on success, zero otherwise
+ */
+static int _safe_string_intern_rehash(safe_string_intern_t table, unsigned long int slot_count)
+{
+	uint32_t *slots = (uint32_t *)_safe_string_calloc(slot_count, sizeof(uint32_t));
+
+	if(slots) {
+		unsigned long int i = 0, j = 0;
+
+		for(i = 0; i < table->count; i++) {
+			for(j = table->hashes[i] & (slot_count - 1); slots[j]; j = (j + 1) & (slot_count - 1)) {
+				; /* linear probing */
+			}
+			slots[j] = (uint32_t)(i + 1);
+		}
+
+		_safe_string_free(table->slots);
+		table->slots = slots;
+		table->slot_count = slot_count;
+		return(!SAFE_STRING_EMPTY);
+	} else {
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Makes room within an interning table for another string
+ * @param table destination table
+ * @return Non-zero on success, zero otherwise
+ */
+static int _safe_string_intern_reserve(safe_string_intern_t table)
+{
+	if(table->count == table->capacity) {
+		unsigned long int capacity = table->capacity * 2;
+		s_string_t *strings = (s_string_t *)_safe_string_realloc(table->strings, capacity * sizeof(s_string_t));
+		uint32_t *hashes;
+
+		if(!strings) {
+			return(SAFE_STRING_EMPTY);
+		}
+		table->strings = strings;
+
+		if(!(hashes = (uint32_t *)_safe_string_realloc(table->hashes, capacity * sizeof(uint32_t)))) {
+			return(SAFE_STRING_EMPTY);
+		}
+		table->hashes = hashes;
+		table->capacity = capacity;
+	}
+
+	if((table->count + 1) * 2 > table->slot_count) { /* keep the table at most half full */
+		return(_safe_string_intern_rehash(table, table->slot_count * 2));
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief Creates a new interning table
+ * @return The newly created table, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note A table must not be used by multiple threads at once
+ */
+safe_string_intern_t safe_string_intern_new(void)
+{
+	safe_string_intern_t table = (safe_string_intern_t)_safe_string_calloc(1, sizeof(struct _s_string_intern_t));
+
+	if(table) {
+		table->capacity = _S_INTERN_SLOTS_INITIAL / 2;
+		table->strings = (s_string_t *)_safe_string_malloc(table->capacity * sizeof(s_string_t));
+		table->hashes = (uint32_t *)_safe_string_malloc(table->capacity * sizeof(uint32_t));
+
+		if(table->strings && table->hashes && _safe_string_intern_rehash(table, _S_INTERN_SLOTS_INITIAL)) {
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(table);
+		}
+
+		_safe_string_free(table->strings);
+		_safe_string_free(table->hashes);
+		_safe_string_free(table);
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+	return(SAFE_STRING_INVALID);
+}
+
+/*!
+ * @brief Interns the characters referred to by a view, the characters are only
+ * copied if they haven't been interned before
+ * @param table table to intern into
+ * @param view characters to intern
+ * @param id stores the identifier of the canonical string (can be
+ * SAFE_STRING_INVALID), identifiers are assigned consecutively from 0
+ * @return The canonical string holding the characters, or SAFE_STRING_INVALID if
+ * there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Canonical strings are owned by the table and read-only: modifying them
+ * fails with SAFE_STRING_ERROR_READ_ONLY and deleting them has no effect; equal
+ * contents always give the same string and identifier, so interned strings can
+ * be compared by pointer or identifier
+ */
+s_string_t safe_string_intern_view(safe_string_intern_t table, s_string_view_t view, uint32_t *id)
+{
+	if(table && safe_string_view_valid(view)) {
+		uint32_t hash = _safe_string_intern_hash(view.v_string, view.v_length);
+		unsigned long int i = 0;
+		s_string_t retn;
+
+		for(i = hash & (table->slot_count - 1); table->slots[i]; i = (i + 1) & (table->slot_count - 1)) {
+			unsigned long int j = table->slots[i] - 1;
+
+			retn = table->strings[j];
+
+			if(table->hashes[j] == hash && retn->s_length == view.v_length + 1 && !memcmp(retn->s_string, view.v_string, view.v_length)) {
+				if(id) {
+					*id = (uint32_t)j;
+				}
+				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+				return(retn);
+			}
+		}
+
+		if(table->count >= UINT32_MAX) {
+			safe_string_set_error(SAFE_STRING_ERROR_BAD_VALUE); /* out of identifiers */
+			return(SAFE_STRING_INVALID);
+		}
+
+		if(!_safe_string_intern_reserve(table)) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		if(!(retn = _safe_string_allocate(view.v_length))) {
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_string_allocate */
+		}
+
+		memcpy(retn->s_string, view.v_string, view.v_length);
+		_safe_string_stats_copy(view.v_length);
+		retn->s_flags |= _S_STRING_FLAG_LITERAL; /* guards the stored hash, and the table against a double free */
+
+		for(i = hash & (table->slot_count - 1); table->slots[i]; i = (i + 1) & (table->slot_count - 1)) {
+			; /* the table may have been rebuilt, so find the free slot again */
+		}
+
+		table->strings[table->count] = retn;
+		table->hashes[table->count] = hash;
+		table->slots[i] = (uint32_t)++table->count;
+
+		if(id) {
+			*id = (uint32_t)(table->count - 1);
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Interns the contents of a string, the contents are only copied if they
+ * haven't been interned before
+ * @param table table to intern into
+ * @param str string to intern
+ * @param id stores the identifier of the canonical string (can be
+ * SAFE_STRING_INVALID)
+ * @return The canonical string holding the contents, or SAFE_STRING_INVALID if
+ * there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Canonical strings are owned by the table and read-only: modifying them
+ * fails with SAFE_STRING_ERROR_READ_ONLY and deleting them has no effect
+ */
+s_string_t safe_string_intern(safe_string_intern_t table, s_string_t str, uint32_t *id)
+{
+	if(safe_string_valid(str)) {
+		return(safe_string_intern_view(table, _safe_string_view_make(str->s_string, str->s_length - 1), id));
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Finds the canonical string with a given identifier
+ * @param table source table
+ * @param id identifier of the string
+ * @return The canonical string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_string_intern_lookup(safe_string_intern_t table, uint32_t id)
+{
+	if(table) {
+		if(id < table->count) {
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(table->strings[id]);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Gets the amount of canonical strings within an interning table
+ * @param table source table
+ * @return The amount of strings, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+unsigned long int safe_string_intern_count(safe_string_intern_t table)
+{
+	if(table) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(table->count);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Deletes an interning table along with every canonical string within it
+ * @param table table to delete
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_intern_delete(safe_string_intern_t table)
+{
+	if(table) {
+		unsigned long int i = 0;
+
+		for(i = 0; i < table->count; i++) {
+			table->strings[i]->s_flags &= ~_S_STRING_FLAG_LITERAL;
+			safe_string_delete(table->strings[i]);
+		}
+
+		_safe_string_free(table->strings);
+		_safe_string_free(table->hashes);
+		_safe_string_free(table->slots);
+		_safe_string_free(table);
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+}
@@ -0,0 +1,102 @@
+/*!
+ * @file universal/intern.h
+ * @brief Header file for the interning table
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_INTERN_H_
+#define _SAFE_STRING_UNIVERSAL_INTERN_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief Creates a new interning table
+ * @return The newly created table, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note A table must not be used by multiple threads at once
+ */
+extern safe_string_intern_t safe_string_intern_new(void);
+
+/*!
+ * @brief Interns the characters referred to by a view, the characters are only
+ * copied if they haven't been interned before
+ * @param table table to intern into
+ * @param view characters to intern
+ * @param id stores the identifier of the canonical string (can be
+ * SAFE_STRING_INVALID), identifiers are assigned consecutively from 0
+ * @return The canonical string holding the characters, or SAFE_STRING_INVALID if
+ * there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Canonical strings are owned by the table and read-only: modifying them
+ * fails with SAFE_STRING_ERROR_READ_ONLY and deleting them has no effect; equal
+ * contents always give the same string and identifier, so interned strings can
+ * be compared by pointer or identifier
+ */
+extern s_string_t safe_string_intern_view(safe_string_intern_t, s_string_view_t, uint32_t *);
+
+/*!
+ * @brief Interns the contents of a string, the contents are only copied if they
+ * haven't been interned before
+ * @param table table to intern into
+ * @param str string to intern
+ * @param id stores the identifier of the canonical string (can be
+ * SAFE_STRING_INVALID)
+ * @return The canonical string holding the contents, or SAFE_STRING_INVALID if
+ * there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note Canonical strings are owned by the table and read-only: modifying them
+ * fails with SAFE_STRING_ERROR_READ_ONLY and deleting them has no effect
+ */
+extern s_string_t safe_string_intern(safe_string_intern_t, s_string_t, uint32_t *);
+
+/*!
+ * @brief Finds the canonical string with a given identifier
+ * @param table source table
+ * @param id identifier of the string
+ * @return The canonical string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_string_intern_lookup(safe_string_intern_t, uint32_t);
+
+/*!
+ * @brief Gets the amount of canonical strings within an interning table
+ * @param table source table
+ * @return The amount of strings, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern unsigned long int safe_string_intern_count(safe_string_intern_t);
+
+/*!
+ * @brief Deletes an interning table along with every canonical string within it
+ * @param table table to delete
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_intern_delete(safe_string_intern_t);
+
+#endif
@@ -0,0 +1,337 @@
+/*!
+ * @file universal/kernel.c
+ * @brief Implementation of the internal kernels operating on ranges of characters
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memchr, memcmp, memcpy, memmove, memset */
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+/*
+ * The substring search compares a block of candidate first characters and the
+ * block of their last characters against the needle's at once, using the widest
+ * vector unit the library is compiled for; each kind yields a mask holding
+ * _S_RANGE_FIND_STRIDE bits per candidate, set where both characters match.
+ */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _S_RANGE_FIND_WIDTH 32 /*!< (INTERNAL) Amount of candidates tested per block */
+#define _S_RANGE_FIND_STRIDE 1 /*!< (INTERNAL) Amount of mask bits per candidate */
+typedef __m256i _s_range_vector_t; /*!< (INTERNAL) Block of characters */
+#define _S_RANGE_FIND_SPLAT(c) _mm256_set1_epi8(c)
+#define _S_RANGE_FIND_MASK(first, last, p, q) ((unsigned long long int)(unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, _mm256_loadu_si256((const __m256i *)(p))), _mm256_cmpeq_epi8(last, _mm256_loadu_si256((const __m256i *)(q))))))
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define _S_RANGE_FIND_WIDTH 16 /*!< (INTERNAL) Amount of candidates tested per block */
+#define _S_RANGE_FIND_STRIDE 1 /*!< (INTERNAL) Amount of mask bits per candidate */
+typedef __m128i _s_range_vector_t; /*!< (INTERNAL) Block of characters */
+#define _S_RANGE_FIND_SPLAT(c) _mm_set1_epi8(c)
+#define _S_RANGE_FIND_MASK(first, last, p, q) ((unsigned long long int)(unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i *)(p))), _mm_cmpeq_epi8(last, _mm_loadu_si128((const __m128i *)(q))))))
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define _S_RANGE_FIND_WIDTH 16 /*!< (INTERNAL) Amount of candidates tested per block */
+#define _S_RANGE_FIND_STRIDE 4 /*!< (INTERNAL) Amount of mask bits per candidate (narrowing leaves a nibble each) */
+typedef uint8x16_t _s_range_vector_t; /*!< (INTERNAL) Block of characters */
+#define _S_RANGE_FIND_SPLAT(c) vdupq_n_u8((uint8_t)(c))
+#define _S_RANGE_FIND_MASK(first, last, p, q) ((unsigned long long int)vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vandq_u8(vceqq_u8(first, vld1q_u8((const uint8_t *)(p))), vceqq_u8(last, vld1q_u8((const uint8_t *)(q))))), 4)), 0))
+#endif
+
+/*
+ * These kernels perform no validation and never touch the error variable; the
+ * public functions validate their arguments once, then hand the ranges they
+ * have checked to these.
+ */
+
+/*!
+ * @brief (INTERNAL) Compares two single characters irrespective of their case
+ * @param c1 character to compare
+ * @param c2 character to compare
+ * @return Computes the result of c1 - c2 where c1 and c2 are the same case
+ * given they are from the standard ASCII alphabet
+ */
+static inline int _safe_string_char_case_compare(char c1, char c2)
+{
+	if(!((c1 == c2) || (c1 < 'A' || c1 > 'z' || c2 < 'A' || c2 > 'z'))) {
+		if(c1 <= 'Z') {
+			c1 += 32;
+		} else {
+			c1 -= 32;
+		}
+	}
+	return(c1 - c2);
+}
+
+/*!
+ * @brief (INTERNAL) Copies a range of characters, which may overlap the
+ * destination
+ * @param dest destination range (must hold at least 'length' characters)
+ * @param src source range
+ * @param length amount of characters to copy
+ */
+void _safe_string_range_copy(char *dest, const char *src, unsigned long int length)
+{
+	if(length && dest != src) {
+		memmove(dest, src, length);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Sets every character within a range to a given character
+ * @param dest destination range (must hold at least 'length' characters)
+ * @param c character to fill the range with
+ * @param length amount of characters to set
+ */
+void _safe_string_range_fill(char *dest, char c, unsigned long int length)
+{
+	if(length) {
+		memset(dest, c, length);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Compares two ranges of characters, a word at a time until
+ * they differ
+ * @param s1 range to compare
+ * @param s2 range to compare
+ * @param length amount of characters to compare from each range
+ * @return The difference between the first characters which aren't equal,
+ * computed as s1[i] - s2[i] on unsigned characters, or 0 in the case of no
+ * differences
+ */
+int _safe_string_range_compare(const char *s1, const char *s2, unsigned long int length)
+{
+	const unsigned char *u1 = (const unsigned char *)s1, *u2 = (const unsigned char *)s2;
+	unsigned long int i = 0;
+
+	for(i = 0; i + sizeof(unsigned long int) <= length; i += sizeof(unsigned long int)) {
+		unsigned long int w1, w2;
+
+		memcpy(&w1, u1 + i, sizeof(unsigned long int)); /* the ranges needn't be aligned */
+		memcpy(&w2, u2 + i, sizeof(unsigned long int));
+
+		if(w1 != w2) {
+			break; /* the difference lies within this word */
+		}
+	}
+
+	for(; i < length; i++) {
+		if(u1[i] != u2[i]) {
+			return(u1[i] - u2[i]);
+		}
+	}
+
+	return(0);
+}
+
+/*!
+ * @brief (INTERNAL) Compares two ranges of characters irrespective of their case
+ * @param s1 range to compare
+ * @param s2 range to compare
+ * @param length amount of characters to compare from each range
+ * @return The difference between the first characters which aren't equal, where
+ * characters from the alphabet are compared using the same case, or 0 in the
+ * case of no differences
+ */
+int _safe_string_range_case_compare(const char *s1, const char *s2, unsigned long int length)
+{
+	unsigned long int i = 0;
+	int diff = 0;
+
+	for(i = 0; i < length && !diff; i++) {
+		diff = _safe_string_char_case_compare(s1[i], s2[i]);
+	}
+
+	return(diff);
+}
+
+/*!
+ * @brief (INTERNAL) Builds the table describing a set of characters, used to
+ * scan ranges for them
+ * @param table destination table (must hold _S_RANGE_TABLE_SIZE entries)
+ * @param set characters within the set
+ * @param length amount of characters within the set
+ */
+void _safe_string_range_table(unsigned char *table, const char *set, unsigned long int length)
+{
+	unsigned long int i = 0;
+
+	memset(table, 0, _S_RANGE_TABLE_SIZE);
+
+	for(i = 0; i < length; i++) {
+		table[(unsigned char)set[i]] = 1;
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Scans a range from the start for the first character whose
+ * membership of a set matches the one given
+ * @param str source range
+ * @param length amount of characters within the range
+ * @param table set of characters (see _safe_string_range_table)
+ * @param member non-zero to stop at a character within the set, zero to stop at
+ * one outside of it
+ * @return The amount of characters preceding the one found, or the length of the
+ * range if there is none
+ */
+unsigned long int _safe_string_range_scan(const char *str, unsigned long int length, const unsigned char *table, int member)
+{
+	unsigned long int i = 0;
+
+	member = !!member;
+
+	for(i = 0; i < length; i++) {
+		if(table[(unsigned char)str[i]] == member) {
+			break;
+		}
+	}
+
+	return(i);
+}
+
+/*!
+ * @brief (INTERNAL) Scans a range from the end for the last character whose
+ * membership of a set matches the one given
+ * @param str source range
+ * @param length amount of characters within the range
+ * @param table set of characters (see _safe_string_range_table)
+ * @param member non-zero to stop at a character within the set, zero to stop at
+ * one outside of it
+ * @return The amount of characters following the one found, or the length of the
+ * range if there is none
+ */
+unsigned long int _safe_string_range_scan_reverse(const char *str, unsigned long int length, const unsigned char *table, int member)
+{
+	unsigned long int i = 0;
+
+	member = !!member;
+
+	for(i = 0; i < length; i++) {
+		if(table[(unsigned char)str[length - i - 1]] == member) {
+			break;
+		}
+	}
+
+	return(i);
+}
+
+/*!
+ * @brief (INTERNAL) Searches a range for a needle one candidate at a time, using
+ * memchr to skip to each occurance of the needle's first character
+ * @param haystack source range
+ * @param offset offset to start the search from
+ * @param length amount of characters within the source range
+ * @param needle characters to find
+ * @param needle_length amount of characters to find (at least one and no more
+ * than 'length')
+ * @return The offset of the first occurance, or 'length' if there is none
+ */
+static unsigned long int _safe_string_range_find_scalar(const char *haystack, unsigned long int offset, unsigned long int length, const char *needle, unsigned long int needle_length)
+{
+	unsigned long int last = length - needle_length; /* the last offset a match can start at */
+	const char *candidate = NULL;
+
+	while(offset <= last && (candidate = (const char *)memchr(haystack + offset, needle[0], last - offset + 1))) {
+		offset = candidate - haystack;
+
+		if(haystack[offset + needle_length - 1] == needle[needle_length - 1] && !memcmp(haystack + offset, needle, needle_length)) {
+			return(offset);
+		}
+
+		offset++;
+	}
+
+	return(length);
+}
+
+/*!
+ * @brief (INTERNAL) Searches a range for the first occurance of a needle
+ * @param haystack source range
+ * @param length amount of characters within the source range
+ * @param needle characters to find
+ * @param needle_length amount of characters to find
+ * @return The offset of the first occurance, where the needle lies entirely
+ * within the range, or the length of the range if there is none (an empty
+ * needle is found at the start)
+ */
+unsigned long int _safe_string_range_find(const char *haystack, unsigned long int length, const char *needle, unsigned long int needle_length)
+{
+	unsigned long int offset = 0;
+
+	if(!needle_length) {
+		return(0);
+	} else if(needle_length > length) {
+		return(length);
+	} else if(needle_length == 1) {
+		const char *found = (const char *)memchr(haystack, needle[0], length);
+
+		return(found ? (unsigned long int)(found - haystack) : length);
+	}
+
+#ifdef _S_RANGE_FIND_WIDTH
+	{
+		_s_range_vector_t first = _S_RANGE_FIND_SPLAT(needle[0]), last = _S_RANGE_FIND_SPLAT(needle[needle_length - 1]);
+
+		/* the block of last characters must lie within the range too */
+		for(; offset + needle_length - 1 + _S_RANGE_FIND_WIDTH <= length; offset += _S_RANGE_FIND_WIDTH) {
+			unsigned long long int mask = _S_RANGE_FIND_MASK(first, last, haystack + offset, haystack + offset + needle_length - 1);
+
+			while(mask) {
+				unsigned long int candidate = __builtin_ctzll(mask) / _S_RANGE_FIND_STRIDE;
+
+				if(!memcmp(haystack + offset + candidate + 1, needle + 1, needle_length - 2)) { /* both ends already match */
+					return(offset + candidate);
+				}
+
+				mask &= ~(((1ULL << _S_RANGE_FIND_STRIDE) - 1) << (candidate * _S_RANGE_FIND_STRIDE));
+			}
+		}
+	}
+#endif
+
+	return(_safe_string_range_find_scalar(haystack, offset, length, needle, needle_length)); /* the remainder, or all of it without a vector unit */
+}
+
+/*!
+ * @brief (INTERNAL) Reverses the order of the characters within a range
+ * @param str destination range
+ * @param length amount of characters within the range
+ */
+void _safe_string_range_reverse(char *str, unsigned long int length)
+{
+	char *end = str + length;
+
+	while(length > 1 && str < --end) {
+		char c = *str;
+
+		*str++ = *end;
+		*end = c;
+	}
+}
@@ -0,0 +1,134 @@
+/*!
+ * @file universal/kernel.h
+ * @brief Header file for the internal kernels operating on ranges of characters
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_KERNEL_H_
+#define _SAFE_STRING_UNIVERSAL_KERNEL_H_
+
+#include "types/types.h"
+
+#define _S_RANGE_TABLE_SIZE 256 /*!< (INTERNAL) Amount of entries within a table describing a set of characters */
+
+/*!
+ * @brief (INTERNAL) Copies a range of characters, which may overlap the
+ * destination
+ * @param dest destination range (must hold at least 'length' characters)
+ * @param src source range
+ * @param length amount of characters to copy
+ */
+extern void _safe_string_range_copy(char *, const char *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Sets every character within a range to a given character
+ * @param dest destination range (must hold at least 'length' characters)
+ * @param c character to fill the range with
+ * @param length amount of characters to set
+ */
+extern void _safe_string_range_fill(char *, char, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Compares two ranges of characters, a word at a time until
+ * they differ
+ * @param s1 range to compare
+ * @param s2 range to compare
+ * @param length amount of characters to compare from each range
+ * @return The difference between the first characters which aren't equal,
+ * computed as s1[i] - s2[i] on unsigned characters, or 0 in the case of no
+ * differences
+ */
+extern int _safe_string_range_compare(const char *, const char *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Compares two ranges of characters irrespective of their case
+ * @param s1 range to compare
+ * @param s2 range to compare
+ * @param length amount of characters to compare from each range
+ * @return The difference between the first characters which aren't equal, where
+ * characters from the alphabet are compared using the same case, or 0 in the
+ * case of no differences
+ */
+extern int _safe_string_range_case_compare(const char *, const char *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Builds the table describing a set of characters, used to
+ * scan ranges for them
+ * @param table destination table (must hold _S_RANGE_TABLE_SIZE entries)
+ * @param set characters within the set
+ * @param length amount of characters within the set
+ */
+extern void _safe_string_range_table(unsigned char *, const char *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Scans a range from the start for the first character whose
+ * membership of a set matches the one given
+ * @param str source range
+ * @param length amount of characters within the range
+ * @param table set of characters (see _safe_string_range_table)
+ * @param member non-zero to stop at a character within the set, zero to stop at
+ * one outside of it
+ * @return The amount of characters preceding the one found, or the length of the
+ * range if there is none
+ */
+extern unsigned long int _safe_string_range_scan(const char *, unsigned long int, const unsigned char *, int);
+
+/*!
+ * @brief (INTERNAL) Scans a range from the end for the last character whose
+ * membership of a set matches the one given
+ * @param str source range
+ * @param length amount of characters within the range
+ * @param table set of characters (see _safe_string_range_table)
+ * @param member non-zero to stop at a character within the set, zero to stop at
+ * one outside of it
+ * @return The amount of characters following the one found, or the length of the
+ * range if there is none
+ */
+extern unsigned long int _safe_string_range_scan_reverse(const char *, unsigned long int, const unsigned char *, int);
+
+/*!
+ * @brief (INTERNAL) Searches a range for the first occurance of a needle
+ * @param haystack source range
+ * @param length amount of characters within the source range
+ * @param needle characters to find
+ * @param needle_length amount of characters to find
+ * @return The offset of the first occurance, where the needle lies entirely
+ * within the range, or the length of the range if there is none (an empty
+ * needle is found at the start)
+ */
+extern unsigned long int _safe_string_range_find(const char *, unsigned long int, const char *, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Reverses the order of the characters within a range
+ * @param str destination range
+ * @param length amount of characters within the range
+ */
+extern void _safe_string_range_reverse(char *, unsigned long int);
+
+#endif
@@ -0,0 +1,178 @@
+/*!
+ * @file universal/map.c
+ * @brief Strings mapped from files
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE /* mremap */
+#include <fcntl.h> /* open */
+#include <string.h> /* memset */
+#include <sys/mman.h> /* mmap, mremap, munmap, madvise */
+#include <sys/stat.h> /* fstat */
+#include <unistd.h> /* close, sysconf */
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+/*!
+ * @brief Creates a string over the contents of a file by mapping it into memory
+ * rather than reading it
+ * @param path path of the file to map
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The mapping is read-only and private: functions which only read the
+ * string use it directly, functions which modify the string first copy it's
+ * contents to the heap; the file is unmapped when the string is deleted
+ */
+s_string_t safe_string_map_file(const char *path)
+{
+	if(path) {
+		unsigned long int size = 0;
+		s_string_t rstring = SAFE_STRING_INVALID;
+		struct stat info;
+		char *region;
+		int fd;
+
+		if((fd = open(path, O_RDONLY)) < 0) {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		}
+
+		if(fstat(fd, &info) < 0 || !S_ISREG(info.st_mode)) {
+			close(fd);
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		}
+
+		if(!info.st_size) {
+			close(fd);
+			return(safe_string_new(SAFE_STRING_INVALID)); /* nothing to map, use the error code from safe_string_new */
+		}
+
+		size = _safe_string_map_size(info.st_size + 1); /* room for the terminator */
+
+		if(size > SAFE_STRING_SIZE_MAX) {
+			close(fd);
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC); /* too large to be held by a string */
+			return(SAFE_STRING_INVALID);
+		}
+
+		/* reserve zeroed pages first, so a terminator follows the file even when it fills it's last page */
+		if((region = (char *)mmap(SAFE_STRING_INVALID, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED) {
+			close(fd);
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		if(mmap(region, info.st_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED || !(rstring = _safe_string_cache_allocate_header())) {
+			munmap(region, size);
+			close(fd);
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		close(fd); /* the mapping holds it's own reference to the file */
+		madvise(region, info.st_size, MADV_SEQUENTIAL);
+
+		memset(rstring, 0, sizeof(_s_string_t));
+		rstring->s_string = region;
+		rstring->s_length = info.st_size + 1;
+		rstring->s_capacity = size; /* the size of the mapping, used to unmap it */
+		rstring->s_flags = _S_STRING_FLAG_MAPPED;
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_NEW, sizeof(_s_string_t) + SAFE_STRING_INLINE_SIZE);
+		_safe_string_stats_live(1, sizeof(_s_string_t) + SAFE_STRING_INLINE_SIZE);
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(rstring);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Unmaps the file a string maps
+ * @param str source string (must have the _S_STRING_FLAG_MAPPED flag set)
+ */
+void _safe_string_unmap(s_string_t str)
+{
+	munmap(str->s_string, str->s_capacity);
+	str->s_flags &= ~_S_STRING_FLAG_MAPPED;
+}
+
+/*!
+ * @brief (INTERNAL) Rounds a buffer size up to a whole amount of pages
+ * @param size minimum size of the buffer
+ * @return The size of the buffer
+ */
+unsigned long int _safe_string_map_size(unsigned long int size)
+{
+	unsigned long int page = (unsigned long int)sysconf(_SC_PAGESIZE);
+
+	return(((size + page - 1) / page) * page);
+}
+
+/*!
+ * @brief (INTERNAL) Allocates a buffer as an anonymous mapping
+ * @param size size of the buffer (see _safe_string_map_size)
+ * @return The allocated (zeroed) buffer, or SAFE_STRING_INVALID if there was an error
+ */
+void *_safe_string_map_allocate(unsigned long int size)
+{
+	void *retn = mmap(SAFE_STRING_INVALID, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	return((retn == MAP_FAILED) ? SAFE_STRING_INVALID : retn);
+}
+
+/*!
+ * @brief (INTERNAL) Resizes a buffer allocated as an anonymous mapping; the
+ * kernel moves the pages rather than copying their contents
+ * @param ptr buffer to resize
+ * @param old_size current size of the buffer
+ * @param size new size of the buffer (see _safe_string_map_size)
+ * @return The resized buffer, or SAFE_STRING_INVALID if there was an error (the
+ * buffer is left untouched)
+ */
+void *_safe_string_map_reallocate(void *ptr, unsigned long int old_size, unsigned long int size)
+{
+	void *retn = mremap(ptr, old_size, size, MREMAP_MAYMOVE);
+
+	return((retn == MAP_FAILED) ? SAFE_STRING_INVALID : retn);
+}
+
+/*!
+ * @brief (INTERNAL) Releases a buffer allocated as an anonymous mapping
+ * @param ptr buffer to release
+ * @param size size of the buffer
+ */
+void _safe_string_map_release(void *ptr, unsigned long int size)
+{
+	munmap(ptr, size);
+}
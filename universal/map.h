@@ -0,0 +1,88 @@
+/*!
+ * @file universal/map.h
+ * @brief Header file for strings mapped from files
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_MAP_H_
+#define _SAFE_STRING_UNIVERSAL_MAP_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief Creates a string over the contents of a file by mapping it into memory
+ * rather than reading it
+ * @param path path of the file to map
+ * @return The newly created string, or an invalid string if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The mapping is read-only and private: functions which only read the
+ * string use it directly, functions which modify the string first copy it's
+ * contents to the heap; the file is unmapped when the string is deleted
+ */
+extern s_string_t safe_string_map_file(const char *);
+
+/*!
+ * @brief (INTERNAL) Unmaps the file a string maps
+ * @param str source string (must have the _S_STRING_FLAG_MAPPED flag set)
+ */
+extern void _safe_string_unmap(s_string_t);
+
+/*!
+ * @brief (INTERNAL) Rounds a buffer size up to a whole amount of pages
+ * @param size minimum size of the buffer
+ * @return The size of the buffer
+ */
+extern unsigned long int _safe_string_map_size(unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Allocates a buffer as an anonymous mapping
+ * @param size size of the buffer (see _safe_string_map_size)
+ * @return The allocated (zeroed) buffer, or SAFE_STRING_INVALID if there was an error
+ */
+extern void *_safe_string_map_allocate(unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Resizes a buffer allocated as an anonymous mapping; the
+ * kernel moves the pages rather than copying their contents
+ * @param ptr buffer to resize
+ * @param old_size current size of the buffer
+ * @param size new size of the buffer (see _safe_string_map_size)
+ * @return The resized buffer, or SAFE_STRING_INVALID if there was an error (the
+ * buffer is left untouched)
+ */
+extern void *_safe_string_map_reallocate(void *, unsigned long int, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Releases a buffer allocated as an anonymous mapping
+ * @param ptr buffer to release
+ * @param size size of the buffer
+ */
+extern void _safe_string_map_release(void *, unsigned long int);
+
+#endif
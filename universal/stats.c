@@ -0,0 +1,321 @@
+/*!
+ * @file universal/stats.c
+ * @brief Per-thread counters of allocations and bytes copied
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <string.h> /* memset */
+#include "types/types.h"
+#include "universal.h"
+#include "macro.h"
+
+/*!
+ * @brief (INTERNAL) Counters kept by a single thread; only the owning thread
+ * writes them, other threads read them when taking a process wide snapshot
+ */
+struct _s_stats_thread_t {
+	s_string_stats_t counters; /*!< Statistics of the thread */
+	long int unpublished; /*!< Live bytes not yet added to the process wide total */
+	int registered; /*!< Non-zero once the counters are linked into the list of threads */
+	struct _s_stats_thread_t *next; /*!< Next thread within the list of threads */
+	struct _s_stats_thread_t *prev; /*!< Previous thread within the list of threads */
+};
+
+#define _S_STATS_PUBLISH 65536 /*!< (INTERNAL) Live bytes a thread accumulates before adding them to the process wide total */
+
+/*!
+ * @brief (INTERNAL) Updates a counter of the calling thread; the store is atomic
+ * so snapshots taken by other threads never observe a torn value, but no
+ * synchronisation is required as only the owning thread writes
+ */
+#define _S_STATS_ADD(f, n) __atomic_store_n(&(f), (f) + (n), __ATOMIC_RELAXED)
+
+/* __thread: stored in TLS (linux) */
+__thread struct _s_stats_thread_t _s_stats_thread; /*!< (INTERNAL) Counters of the calling thread (thread safe) */
+
+static pthread_mutex_t _s_stats_lock = PTHREAD_MUTEX_INITIALIZER; /*!< (INTERNAL) Guards the list of threads, the retired and the baseline counters */
+static pthread_once_t _s_stats_once = PTHREAD_ONCE_INIT; /*!< (INTERNAL) Creates the key used to retire threads */
+static pthread_key_t _s_stats_key; /*!< (INTERNAL) Key whose destructor retires a thread's counters on exit */
+static struct _s_stats_thread_t *_s_stats_threads = SAFE_STRING_INVALID; /*!< (INTERNAL) Counters of every running thread which has allocated */
+static s_string_stats_t _s_stats_retired; /*!< (INTERNAL) Counters of threads which have exited */
+static s_string_stats_t _s_stats_baseline; /*!< (INTERNAL) Process wide call and byte counters at the last reset */
+static long int _s_stats_live_bytes = 0; /*!< (INTERNAL) Live bytes published by every thread (updated atomically) */
+static long int _s_stats_peak_live_bytes = 0; /*!< (INTERNAL) Highest value of the published live bytes (updated atomically) */
+
+/*!
+ * @brief (INTERNAL) Adds the call and byte counters of one snapshot to another
+ * @param dest destination snapshot
+ * @param src source snapshot (read atomically, it may belong to a running thread)
+ */
+static void _safe_string_stats_sum(s_string_stats_t *dest, s_string_stats_t *src)
+{
+	unsigned long int i = 0;
+
+	for(i = 0; i < SAFE_STRING_STATS_SITES; i++) {
+		dest->st_calls[i] += __atomic_load_n(&src->st_calls[i], __ATOMIC_RELAXED);
+	}
+
+	dest->st_bytes_allocated += __atomic_load_n(&src->st_bytes_allocated, __ATOMIC_RELAXED);
+	dest->st_bytes_copied += __atomic_load_n(&src->st_bytes_copied, __ATOMIC_RELAXED);
+	dest->st_live_strings += __atomic_load_n(&src->st_live_strings, __ATOMIC_RELAXED);
+	dest->st_live_bytes += __atomic_load_n(&src->st_live_bytes, __ATOMIC_RELAXED);
+}
+
+/*!
+ * @brief (INTERNAL) Publishes the live bytes a thread has accumulated
+ * @param thread counters of the calling thread
+ */
+static void _safe_string_stats_publish(struct _s_stats_thread_t *thread)
+{
+	long int live = __atomic_add_fetch(&_s_stats_live_bytes, thread->unpublished, __ATOMIC_RELAXED);
+	long int peak = __atomic_load_n(&_s_stats_peak_live_bytes, __ATOMIC_RELAXED);
+
+	while(live > peak && !__atomic_compare_exchange_n(&_s_stats_peak_live_bytes, &peak, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+		; /* peak is reloaded on failure */
+	}
+
+	thread->unpublished = 0;
+}
+
+/*!
+ * @brief (INTERNAL) Folds the counters of an exiting thread into the retired
+ * counters and unlinks them
+ * @param data counters of the exiting thread
+ */
+static void _safe_string_stats_retire(void *data)
+{
+	struct _s_stats_thread_t *thread = (struct _s_stats_thread_t *)data;
+
+	pthread_mutex_lock(&_s_stats_lock);
+
+	_safe_string_stats_sum(&_s_stats_retired, &thread->counters);
+	_safe_string_stats_publish(thread);
+
+	if(thread->prev) {
+		thread->prev->next = thread->next;
+	} else {
+		_s_stats_threads = thread->next;
+	}
+
+	if(thread->next) {
+		thread->next->prev = thread->prev;
+	}
+
+	memset(thread, 0, sizeof(struct _s_stats_thread_t)); /* registers again if the thread allocates after this */
+
+	pthread_mutex_unlock(&_s_stats_lock);
+}
+
+/*!
+ * @brief (INTERNAL) Creates the key used to retire threads
+ */
+static void _safe_string_stats_key(void)
+{
+	pthread_key_create(&_s_stats_key, _safe_string_stats_retire);
+}
+
+/*!
+ * @brief (INTERNAL) Obtains the counters of the calling thread, linking them
+ * into the list of threads on first use
+ * @return The counters of the calling thread
+ */
+static inline struct _s_stats_thread_t *_safe_string_stats_self(void)
+{
+	struct _s_stats_thread_t *thread = &_s_stats_thread;
+
+	if(!thread->registered) {
+		pthread_once(&_s_stats_once, _safe_string_stats_key);
+
+		pthread_mutex_lock(&_s_stats_lock);
+
+		thread->registered = !SAFE_STRING_EMPTY;
+		thread->prev = SAFE_STRING_INVALID;
+		thread->next = _s_stats_threads;
+
+		if(_s_stats_threads) {
+			_s_stats_threads->prev = thread;
+		}
+
+		_s_stats_threads = thread;
+
+		pthread_mutex_unlock(&_s_stats_lock);
+
+		pthread_setspecific(_s_stats_key, thread);
+	}
+
+	return(thread);
+}
+
+/*!
+ * @brief (INTERNAL) Counts an allocation made by a site
+ * @param site site making the allocation
+ * @param bytes amount of bytes allocated
+ */
+void _safe_string_stats_allocate(s_string_stats_site_t site, unsigned long int bytes)
+{
+	struct _s_stats_thread_t *thread = _safe_string_stats_self();
+
+	_S_STATS_ADD(thread->counters.st_calls[site], 1);
+	_S_STATS_ADD(thread->counters.st_bytes_allocated, bytes);
+}
+
+/*!
+ * @brief (INTERNAL) Counts a change in the amount of live heap strings and the
+ * bytes they hold
+ * @param strings change in the amount of live strings
+ * @param bytes change in the amount of bytes held
+ */
+void _safe_string_stats_live(long int strings, long int bytes)
+{
+	struct _s_stats_thread_t *thread = _safe_string_stats_self();
+
+	_S_STATS_ADD(thread->counters.st_live_strings, strings);
+	_S_STATS_ADD(thread->counters.st_live_bytes, bytes);
+
+	if(thread->counters.st_live_bytes > thread->counters.st_peak_live_bytes) {
+		__atomic_store_n(&thread->counters.st_peak_live_bytes, thread->counters.st_live_bytes, __ATOMIC_RELAXED);
+	}
+
+	thread->unpublished += bytes;
+
+	if(thread->unpublished >= _S_STATS_PUBLISH || thread->unpublished <= -_S_STATS_PUBLISH) {
+		_safe_string_stats_publish(thread); /* the only write to the shared totals, once per batch */
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Counts characters copied from one buffer to another
+ * @param bytes amount of characters copied
+ */
+void _safe_string_stats_copy(unsigned long int bytes)
+{
+	struct _s_stats_thread_t *thread = _safe_string_stats_self();
+
+	_S_STATS_ADD(thread->counters.st_bytes_copied, bytes);
+}
+
+/*!
+ * @brief Takes a snapshot of the statistics of the calling thread
+ * @param stats stores the snapshot
+ * @note Live values count strings created by the thread less those deleted by
+ * it, so they can be negative for threads which delete strings created by others
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_stats_thread(s_string_stats_t *stats)
+{
+	if(stats) {
+		*stats = _s_stats_thread.counters;
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Takes a snapshot of the statistics of the whole process, including
+ * threads which have exited
+ * @param stats stores the snapshot
+ * @note Sets the error variable indicating success or failure
+ * @note Threads publish their live bytes in batches of 64 KiB to avoid contention,
+ * so the peak can lag the true peak by up to that amount per thread
+ */
+void safe_string_stats_process(s_string_stats_t *stats)
+{
+	if(stats) {
+		struct _s_stats_thread_t *thread = SAFE_STRING_INVALID;
+		unsigned long int i = 0;
+
+		memset(stats, 0, sizeof(s_string_stats_t));
+
+		pthread_mutex_lock(&_s_stats_lock);
+
+		_safe_string_stats_sum(stats, &_s_stats_retired);
+
+		for(thread = _s_stats_threads; thread; thread = thread->next) {
+			_safe_string_stats_sum(stats, &thread->counters);
+		}
+
+		for(i = 0; i < SAFE_STRING_STATS_SITES; i++) {
+			stats->st_calls[i] -= _s_stats_baseline.st_calls[i];
+		}
+
+		stats->st_bytes_allocated -= _s_stats_baseline.st_bytes_allocated;
+		stats->st_bytes_copied -= _s_stats_baseline.st_bytes_copied;
+
+		pthread_mutex_unlock(&_s_stats_lock);
+
+		stats->st_peak_live_bytes = MAX(stats->st_live_bytes, __atomic_load_n(&_s_stats_peak_live_bytes, __ATOMIC_RELAXED));
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Resets the call and byte counters of the calling thread and of the
+ * process, and restarts peak tracking from the current live bytes
+ * @note Sets the error variable indicating success or failure
+ * @note Counters of other threads are left untouched, the process counters
+ * discount them from the point of the reset
+ */
+void safe_string_stats_reset(void)
+{
+	struct _s_stats_thread_t *thread = _safe_string_stats_self();
+	unsigned long int i = 0;
+
+	for(i = 0; i < SAFE_STRING_STATS_SITES; i++) {
+		__atomic_store_n(&thread->counters.st_calls[i], 0, __ATOMIC_RELAXED);
+	}
+
+	__atomic_store_n(&thread->counters.st_bytes_allocated, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&thread->counters.st_bytes_copied, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&thread->counters.st_peak_live_bytes, thread->counters.st_live_bytes, __ATOMIC_RELAXED);
+
+	pthread_mutex_lock(&_s_stats_lock);
+
+	memset(&_s_stats_baseline, 0, sizeof(s_string_stats_t));
+	_safe_string_stats_sum(&_s_stats_baseline, &_s_stats_retired);
+
+	for(thread = _s_stats_threads; thread; thread = thread->next) {
+		_safe_string_stats_sum(&_s_stats_baseline, &thread->counters);
+	}
+
+	__atomic_store_n(&_s_stats_peak_live_bytes, _s_stats_baseline.st_live_bytes, __ATOMIC_RELAXED);
+
+	pthread_mutex_unlock(&_s_stats_lock);
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+}
@@ -0,0 +1,110 @@
+/*!
+ * @file universal/stats.h
+ * @brief Header file for the allocation statistics
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UNIVERSAL_STATS_H_
+#define _SAFE_STRING_UNIVERSAL_STATS_H_
+
+/*!
+ * @brief Type definition for the sites allocations are counted against
+ */
+typedef enum { \
+	SAFE_STRING_STATS_NEW /*!< Strings created from C strings (safe_string_new and friends) */, \
+	SAFE_STRING_STATS_ALLOCATE /*!< Strings created to hold results (substring, duplicate, join, split, ...) */, \
+	SAFE_STRING_STATS_SHARE /*!< Duplicates sharing the buffer of another string */, \
+	SAFE_STRING_STATS_REALLOCATE /*!< Buffers moved to grow or shrink a string (concatenate, copy, pad, reserve, ...) */, \
+	SAFE_STRING_STATS_ARRAY /*!< Arrays created to hold results (split, token_split, index_split, chunk_split, ...) */, \
+	SAFE_STRING_STATS_ARENA /*!< Arenas and the blocks they allocate, which hold arena and batch strings (safe_string_new_in, safe_string_new_batch, ...) */, \
+	SAFE_STRING_STATS_SITES /*!< Amount of sites */ \
+} s_string_stats_site_t;
+
+/*!
+ * @brief Type definition for a snapshot of the allocation statistics
+ */
+typedef struct {
+	unsigned long int st_calls[SAFE_STRING_STATS_SITES]; /*!< Allocations made by each site */
+	unsigned long int st_bytes_allocated; /*!< Bytes allocated by every site */
+	unsigned long int st_bytes_copied; /*!< Characters copied from one buffer to another */
+	long int st_live_strings; /*!< Heap strings created less those deleted (arena and batch strings are only counted through their arena's blocks) */
+	long int st_live_bytes; /*!< Bytes held by live heap strings (structures and buffers, excluding arena blocks) */
+	long int st_peak_live_bytes; /*!< Highest value st_live_bytes has reached */
+} s_string_stats_t;
+
+/*!
+ * @brief Takes a snapshot of the statistics of the calling thread
+ * @param stats stores the snapshot
+ * @note Live values count strings created by the thread less those deleted by
+ * it, so they can be negative for threads which delete strings created by others
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_stats_thread(s_string_stats_t *);
+
+/*!
+ * @brief Takes a snapshot of the statistics of the whole process, including
+ * threads which have exited
+ * @param stats stores the snapshot
+ * @note Sets the error variable indicating success or failure
+ * @note Threads publish their live bytes in batches of 64 KiB to avoid contention,
+ * so the peak can lag the true peak by up to that amount per thread
+ */
+extern void safe_string_stats_process(s_string_stats_t *);
+
+/*!
+ * @brief Resets the call and byte counters of the calling thread and of the
+ * process, and restarts peak tracking from the current live bytes
+ * @note Sets the error variable indicating success or failure
+ * @note Counters of other threads are left untouched, the process counters
+ * discount them from the point of the reset
+ */
+extern void safe_string_stats_reset(void);
+
+/*!
+ * @brief (INTERNAL) Counts an allocation made by a site
+ * @param site site making the allocation
+ * @param bytes amount of bytes allocated
+ */
+extern void _safe_string_stats_allocate(s_string_stats_site_t, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Counts a change in the amount of live heap strings and the
+ * bytes they hold
+ * @param strings change in the amount of live strings
+ * @param bytes change in the amount of bytes held
+ */
+extern void _safe_string_stats_live(long int, long int);
+
+/*!
+ * @brief (INTERNAL) Counts characters copied from one buffer to another
+ * @param bytes amount of characters copied
+ */
+extern void _safe_string_stats_copy(unsigned long int);
+
+#endif
@@ -58,5 +58,10 @@
 #include "utility/token_split.h"
 #include "utility/substring_replace.h"
 #include "utility/filter.h"
+#include "utility/duplicate.h"
+#include "utility/packed.h"
+#include "utility/view.h"
+#include "utility/rope.h"
+#include "utility/vec.h"
 
 #endif
@@ -32,12 +32,13 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "types/types.h"
 #include "universal.h"
 #include "utility.h"
 #include "macro.h"
 
-const char *safe_string_access_characters(s_string_t str, unsigned long int *count)
+const char *(safe_string_access_characters)(s_string_t str, unsigned long int *count)
 {
 	if(safe_string_valid(str)) {
 		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
@@ -54,26 +55,14 @@ const char *safe_string_access_characters(s_string_t str, unsigned long int *cou
 char *safe_string_access_characters_duplicate(s_string_t str, unsigned long int *count)
 {
 	if(safe_string_valid(str) && count) {
-		char *retn = (char *)calloc(str->s_length, sizeof(char));
+		char *retn = (char *)_safe_string_malloc(str->s_length * sizeof(char));
 
 		if(retn) {
-			unsigned long int i = 0;
-
-			for(i = 0; i < safe_string_length(str); i++) {
-				retn[i] = safe_string_index(str, i);
-			}
-
-			if(!safe_string_error()) {
-				if(count) {
-					*count = i;
-				}
-				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-				*count = safe_string_length(str);
-				return(retn);
-			} else {
-				free(retn); /* carry the error value */
-				return(SAFE_STRING_INVALID);
-			}
+			memcpy(retn, str->s_string, str->s_length); /* includes the terminator */
+			_safe_string_stats_copy(str->s_length);
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			*count = safe_string_length(str);
+			return(retn);
 		} else {
 			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 			return(SAFE_STRING_INVALID);
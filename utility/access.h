@@ -35,9 +35,31 @@
 #define _SAFE_STRING_UNIVERSAL_ACCESS_H_
 
 #include "types/types.h"
+#include "universal/error.h"
 
 extern const char *safe_string_access_characters(s_string_t, unsigned long int *);
 
 extern char *safe_string_access_characters_duplicate(s_string_t, unsigned long int *);
 
+#ifdef SAFE_STRING_INLINE
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_access_characters, leaving
+ * errors to the library
+ */
+static inline const char *_safe_string_access_characters_inline(s_string_t str, unsigned long int *count)
+{
+	if(safe_string_valid(str)) {
+		_safe_string_error = SAFE_STRING_ERROR_NO_ERROR;
+		if(count) {
+			*count = str->s_length - 1;
+		}
+		return(str->s_string);
+	} else {
+		return((safe_string_access_characters)(str, count));
+	}
+}
+
+#define safe_string_access_characters(str, count) _safe_string_access_characters_inline(str, count)
+#endif
+
 #endif
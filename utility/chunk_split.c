@@ -50,33 +50,38 @@ s_strings_t safe_string_chunk_split(s_string_t str, unsigned long int size, cons
 {
 	if(size) {
 		if(safe_string_valid(str) && count) {
-			s_string_t delimeter = safe_string_new(delim);
-			char *strn = (char *)calloc(size + 1, size);
+			unsigned long int delim_length = delim ? strlen(delim) : 0;
 			*count = (safe_string_length(str) / size) + (safe_string_length(str) % size ? 1 : 0);
 
-			s_strings_t chunks = (s_string_t *)calloc(*count, sizeof(s_string_t));
+			s_strings_t chunks = (s_string_t *)_safe_string_calloc(*count, sizeof(s_string_t));
 
-			if(chunks && strn && delimeter) {
-				unsigned long int i = 0;
+			if(chunks) {
+				unsigned long int i = 0, length = 0;
+
+				_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, *count * sizeof(s_string_t));
 
 				for(i = 0; i < *count; i++) {
-					strncpy(strn, (str->s_string + (i * size)), size);
-					chunks[i] = safe_string_new(strn);
-					safe_string_concatenate(chunks[i], delimeter); 
+					length = MIN(size, safe_string_length(str) - i * size);
+					chunks[i] = _safe_string_allocate(length + delim_length);
 
 					if(!chunks[i]) {
 						while(i) {
 							safe_string_delete(chunks[--i]);
 						}
-						free(chunks);
+						_safe_string_free(chunks);
 						
 						safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 						return(SAFE_STRING_INVALID);
 					}
+
+					memcpy(chunks[i]->s_string, str->s_string + i * size, length); /* chunks may contain NULs */
+					if(delim_length) {
+						memcpy(chunks[i]->s_string + length, delim, delim_length);
+					}
+					_safe_string_stats_copy(length + delim_length);
 				}
 
 				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-				safe_string_delete(delimeter);
 				return(chunks);
 			} else {
 				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
@@ -91,3 +96,54 @@ s_strings_t safe_string_chunk_split(s_string_t str, unsigned long int size, cons
 		return(SAFE_STRING_INVALID);
 	}
 }
+
+/*!
+ * @brief Splits a string into chunks of a certain size, with an optional delimeter concatenated, packing the
+ * result into a single allocation
+ * @param str source string
+ * @param size length of each chunk
+ * @param delim the delimeter to concatenate to each chunk (if NULL then nothing is concatenated)
+ * @return A packed array of strings, or SAFE_STRING_INVALID in case of an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_strings_packed_t safe_string_chunk_split_packed(s_string_t str, unsigned long int size, const char *delim)
+{
+	if(size) {
+		if(safe_string_valid(str)) {
+			unsigned long int i = 0, length = safe_string_length(str), delim_length = delim ? strlen(delim) : 0;
+			unsigned long int count = (length / size) + (length % size ? 1 : 0);
+			s_strings_packed_t retn = _safe_strings_packed_allocate(count, length + count * delim_length);
+
+			if(retn) {
+				for(i = 0; i < count; i++) {
+					_safe_strings_packed_append(retn, str->s_string + (i * size), MIN(size, length - (i * size)), delim, delim_length);
+				}
+			}
+
+			return(retn); /* use the error code from _safe_strings_packed_allocate */
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Splits a string into a vector of chunks of a certain size, with an
+ * optional delimeter concatenated
+ * @param str source string
+ * @param size length of each chunk
+ * @param delim the delimeter to concatenate to each chunk (if NULL then nothing is concatenated)
+ * @return Vector of strings, or SAFE_STRING_INVALID in case of an error
+ * @note Sets the error variable indicating success or failure
+ */
+safe_strings_vec_t safe_string_chunk_split_vec(s_string_t str, unsigned long int size, const char *delim)
+{
+	unsigned long int count = 0;
+	s_strings_t strs = safe_string_chunk_split(str, size, delim, &count);
+
+	return(_safe_strings_vec_adopt(strs, count));
+}
@@ -46,4 +46,26 @@
  */
 extern s_strings_t safe_string_chunk_split(s_string_t, unsigned long int, const char *, unsigned long int *);
 
+/*!
+ * @brief Splits a string into chunks of a certain size, with an optional delimeter concatenated, packing the
+ * result into a single allocation
+ * @param str source string
+ * @param size length of each chunk
+ * @param delim the delimeter to concatenate to each chunk (if NULL then nothing is concatenated)
+ * @return A packed array of strings, or SAFE_STRING_INVALID in case of an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_strings_packed_t safe_string_chunk_split_packed(s_string_t, unsigned long int, const char *);
+
+/*!
+ * @brief Splits a string into a vector of chunks of a certain size, with an
+ * optional delimeter concatenated
+ * @param str source string
+ * @param size length of each chunk
+ * @param delim the delimeter to concatenate to each chunk (if NULL then nothing is concatenated)
+ * @return Vector of strings, or SAFE_STRING_INVALID in case of an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern safe_strings_vec_t safe_string_chunk_split_vec(s_string_t, unsigned long int, const char *);
+
 #endif
@@ -35,6 +35,35 @@
 #include "utility.h"
 #include "macro.h"
 
+/*!
+ * @brief Compares two strings with a limit without touching the error variable
+ * @param str1 string to compare
+ * @param str2 string to compare
+ * @param limit maximum amount of characters to compare from str1
+ * @param diff stores the difference between either where two indexed characters
+ * from str1 and str2 aren't equal; or where the index has reached the limit
+ * value or the end of str1; the difference is computed as follows:
+ * str1[i] - str2[i] or 0 in the case of no differences
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_compare_limit_r(s_string_t str1, s_string_t str2, unsigned long int limit, int *diff)
+{
+	if(!diff) {
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	} else if(safe_string_valid(str1) && safe_string_valid(str2)) {
+		unsigned long int length1 = str1->s_length - 1, length2 = str2->s_length - 1, span = 0;
+
+		limit = MIN(limit, MAX(length1, length2));
+		span = MIN(limit, MIN(length1, length2) + 1); /* the terminator of the shorter string is the last character both hold */
+		*diff = _safe_string_range_compare(str1->s_string, str2->s_string, span);
+
+		return((*diff || span == limit) ? SAFE_STRING_ERROR_NO_ERROR : SAFE_STRING_ERROR_INDEX_BOUNDS);
+	} else {
+		*diff = SAFE_STRING_EMPTY;
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
 /*!
  * @brief Compares two strings with a limit
  * @param str1 string to compare
@@ -48,22 +77,31 @@
  */
 int safe_string_compare_limit(s_string_t str1, s_string_t str2, unsigned long int limit)
 {
-	if(safe_string_valid(str1) && safe_string_valid(str2)) {
-		int diff = 0;
-		unsigned long int i = 0;
+	int diff = SAFE_STRING_EMPTY;
 
-		//limit = (limit > (str1->s_length > str2->s_length ? str1->s_length : str2->s_length) ? (str1->s_length > str2->s_length ? str1->s_length : str2->s_length) : limit);
-		limit = MIN(limit, MAX(safe_string_length(str1), safe_string_length(str2)));
-		while((i < limit) && !diff && !safe_string_error()) {
-			diff = (safe_string_index(str1, i) - safe_string_index(str2, i));
-			i++;
-		}
+	safe_string_set_error(safe_string_compare_limit_r(str1, str2, limit, &diff));
+	return(diff);
+}
 
-		safe_string_set_error(safe_string_error_val());
-		return(diff);
+/*!
+ * @brief Compares two strings without touching the error variable
+ * @param str1 string to compare
+ * @param str2 string to compare
+ * @param diff stores the difference between either where two indexed characters
+ * from str1 and str2 aren't equal; or where the index has reached the end of
+ * str1; the difference is computed as follows: str1[i] - str2[i] or 0 in the
+ * case of no differences
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_compare_r(s_string_t str1, s_string_t str2, int *diff)
+{
+	if(!diff) {
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	} else if(safe_string_valid(str1) && safe_string_valid(str2)) { /* check it's safe to access the structure */
+		return(safe_string_compare_limit_r(str1, str2, MIN(str1->s_length, str2->s_length) - 1, diff));
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return(SAFE_STRING_EMPTY);
+		*diff = SAFE_STRING_EMPTY;
+		return(SAFE_STRING_ERROR_NULL_POINTER);
 	}
 }
 
@@ -79,8 +117,87 @@ int safe_string_compare_limit(s_string_t str1, s_string_t str2, unsigned long in
  */
 int safe_string_compare(s_string_t str1, s_string_t str2)
 {
-	if(safe_string_valid(str1) && safe_string_valid(str2)) { /* check it's safe to access the structure */
-		return(safe_string_compare_limit(str1, str2, MIN(safe_string_length(str1), safe_string_length(str2))));
+	int diff = SAFE_STRING_EMPTY;
+
+	safe_string_set_error(safe_string_compare_r(str1, str2, &diff));
+	return(diff);
+}
+
+/*!
+ * @brief Compares the characters referred to by two views
+ * @param view1 view to compare
+ * @param view2 view to compare
+ * @return The difference between where two indexed characters from view1 and
+ * view2 aren't equal, where the end of the shorter view compares as a
+ * terminator; computed as follows: view1[i] - view2[i] or 0 in the case of no
+ * differences
+ * @note Unlike safe_string_compare, a view which is a prefix of the other
+ * doesn't compare as equal
+ * @note Sets the error variable indicating success or failure
+ */
+int safe_string_compare_view(s_string_view_t view1, s_string_view_t view2)
+{
+	if(safe_string_view_valid(view1) && safe_string_view_valid(view2)) {
+		unsigned long int i = 0, limit = MIN(view1.v_length, view2.v_length);
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+
+		for(i = 0; i < limit; i++) {
+			if(view1.v_string[i] != view2.v_string[i]) {
+				return((unsigned char)view1.v_string[i] - (unsigned char)view2.v_string[i]);
+			}
+		}
+
+		if(view1.v_length > limit) {
+			return((unsigned char)view1.v_string[limit]);
+		} else if(view2.v_length > limit) {
+			return(-(int)(unsigned char)view2.v_string[limit]);
+		} else {
+			return(SAFE_STRING_EMPTY);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Compares a rope with a string, chunk by chunk without flattening the
+ * rope
+ * @param rope rope to compare
+ * @param str string to compare
+ * @return The difference between where two indexed characters from the rope and
+ * the string aren't equal, where the end of the shorter compares as a
+ * terminator; computed as follows: rope[i] - str[i] or 0 in the case of no
+ * differences
+ * @note Sets the error variable indicating success or failure
+ */
+int safe_string_rope_compare(safe_string_rope_t rope, s_string_t str)
+{
+	if(rope && safe_string_valid(str)) {
+		s_string_rope_iterator_t iterator;
+		s_string_view_t chunk;
+		unsigned long int offset = 0;
+		int diff = 0;
+
+		safe_string_rope_iterator(rope, &iterator);
+
+		while(safe_string_rope_iterator_next(&iterator, &chunk)) {
+			unsigned long int remaining = safe_string_length(str) - offset;
+
+			if((diff = safe_string_compare_view(_safe_string_view_make(chunk.v_string, MIN(chunk.v_length, remaining)), _safe_string_view_make(str->s_string + offset, MIN(chunk.v_length, remaining))))) {
+				return(diff);
+			}
+
+			if(chunk.v_length > remaining) {
+				return((unsigned char)chunk.v_string[remaining]);
+			}
+
+			offset += chunk.v_length;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(offset < safe_string_length(str) ? -(int)(unsigned char)str->s_string[offset] : SAFE_STRING_EMPTY);
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
 		return(SAFE_STRING_EMPTY);
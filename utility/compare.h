@@ -34,6 +34,20 @@
 #define _SAFE_STRING_UTILITY_COMPARE_H_
 
 #include "types/types.h"
+#include "universal/error.h"
+
+/*!
+ * @brief Compares two strings with a limit without touching the error variable
+ * @param str1 string to compare
+ * @param str2 string to compare
+ * @param limit maximum amount of characters to compare from str1
+ * @param diff stores the difference between either where two indexed characters
+ * from str1 and str2 aren't equal; or where the index has reached the limit
+ * value or the end of str1; the difference is computed as follows:
+ * str1[i] - str2[i] or 0 in the case of no differences
+ * @return Error code indicating success or failure
+ */
+extern s_string_error_t safe_string_compare_limit_r(s_string_t, s_string_t, unsigned long int, int *);
 
 /*!
  * @brief Compares two strings with a limit
@@ -48,6 +62,18 @@
  */
 extern int safe_string_compare_limit(s_string_t, s_string_t, unsigned long int);
 
+/*!
+ * @brief Compares two strings without touching the error variable
+ * @param str1 string to compare
+ * @param str2 string to compare
+ * @param diff stores the difference between either where two indexed characters
+ * from str1 and str2 aren't equal; or where the index has reached the end of
+ * str1; the difference is computed as follows: str1[i] - str2[i] or 0 in the
+ * case of no differences
+ * @return Error code indicating success or failure
+ */
+extern s_string_error_t safe_string_compare_r(s_string_t, s_string_t, int *);
+
 /*!
  * @brief Compares two strings
  * @param str1 string to compare
@@ -60,4 +86,31 @@ extern int safe_string_compare_limit(s_string_t, s_string_t, unsigned long int);
  */
 extern int safe_string_compare(s_string_t, s_string_t);
 
+/*!
+ * @brief Compares the characters referred to by two views
+ * @param view1 view to compare
+ * @param view2 view to compare
+ * @return The difference between where two indexed characters from view1 and
+ * view2 aren't equal, where the end of the shorter view compares as a
+ * terminator; computed as follows: view1[i] - view2[i] or 0 in the case of no
+ * differences
+ * @note Unlike safe_string_compare, a view which is a prefix of the other
+ * doesn't compare as equal
+ * @note Sets the error variable indicating success or failure
+ */
+extern int safe_string_compare_view(s_string_view_t, s_string_view_t);
+
+/*!
+ * @brief Compares a rope with a string, chunk by chunk without flattening the
+ * rope
+ * @param rope rope to compare
+ * @param str string to compare
+ * @return The difference between where two indexed characters from the rope and
+ * the string aren't equal, where the end of the shorter compares as a
+ * terminator; computed as follows: rope[i] - str[i] or 0 in the case of no
+ * differences
+ * @note Sets the error variable indicating success or failure
+ */
+extern int safe_string_rope_compare(safe_string_rope_t, s_string_t);
+
 #endif
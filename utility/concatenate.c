@@ -30,7 +30,6 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdlib.h>
 #include "types/types.h"
 #include "universal.h"
 #include "utility.h"
@@ -38,54 +37,68 @@
 
 /*!
  * @brief Concatenates a limited amount of characters from one string to another
+ * without touching the error variable
  * @param str1 destination string
  * @param str2 source string
  * @param limit maximum amount of characters to concatenate
- * @note Sets the error variable indicating success or failure
+ * @return Error code indicating success or failure
  */
-void safe_string_concatenate_limit(s_string_t str1, s_string_t str2, unsigned long int limit)
+s_string_error_t safe_string_concatenate_limit_r(s_string_t str1, s_string_t str2, unsigned long int limit)
 {
 	if(safe_string_valid(str1) && safe_string_valid(str2)) {
-		limit = MIN(limit, safe_string_length(str2));
-		char *new = (char *)realloc(str1->s_string, (safe_string_length(str1) + limit + 1) * sizeof(char));
+		s_string_error_t error = SAFE_STRING_ERROR_NO_ERROR;
 
-		if(new) {
-			unsigned long int i = 0, j = 0, old_length = safe_string_length(str1);
-			str1->s_string = new;
-			str1->s_length = safe_string_length(str1) + limit + 1;
+		limit = MIN(limit, str2->s_length - 1);
 
-			/* we also want to copy the null */
-			for(i = old_length, j = 0; i < old_length + limit; i++, j++) {
-				safe_string_index_set(str1, i, safe_string_index(str2, j));
-			}
+		if((error = _safe_string_grow_r(str1, str1->s_length + limit)) == SAFE_STRING_ERROR_NO_ERROR) {
+			unsigned long int old_length = str1->s_length - 1;
 
-			safe_string_index_set(str1, i, '\0');
-			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-			return;
-		} else {
-			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-			return;
+			_safe_string_range_copy(str1->s_string + old_length, str2->s_string, limit); /* str2 may be str1, grown above */
+			str1->s_string[old_length + limit] = '\0';
+			str1->s_length = old_length + limit + 1;
+			_safe_string_stats_copy(limit);
 		}
+
+		return(error);
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return;
+		return(SAFE_STRING_ERROR_NULL_POINTER);
 	}
 }
 
 /*!
- * @brief Concatenates one string to another
+ * @brief Concatenates a limited amount of characters from one string to another
  * @param str1 destination string
  * @param str2 source string
+ * @param limit maximum amount of characters to concatenate
  * @note Sets the error variable indicating success or failure
  */
-void safe_string_concatenate(s_string_t str1, s_string_t str2)
+void safe_string_concatenate_limit(s_string_t str1, s_string_t str2, unsigned long int limit)
+{
+	safe_string_set_error(safe_string_concatenate_limit_r(str1, str2, limit));
+}
+
+/*!
+ * @brief Concatenates one string to another without touching the error variable
+ * @param str1 destination string
+ * @param str2 source string
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_concatenate_r(s_string_t str1, s_string_t str2)
 {
 	if(safe_string_valid(str1) && safe_string_valid(str2)) {
-		safe_string_concatenate_limit(str1, str2, safe_string_length(str2));
-		return;
+		return(safe_string_concatenate_limit_r(str1, str2, str2->s_length - 1));
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return;
+		return(SAFE_STRING_ERROR_NULL_POINTER);
 	}
-	
+}
+
+/*!
+ * @brief Concatenates one string to another
+ * @param str1 destination string
+ * @param str2 source string
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_concatenate(s_string_t str1, s_string_t str2)
+{
+	safe_string_set_error(safe_string_concatenate_r(str1, str2));
 }
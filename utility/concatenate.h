@@ -34,8 +34,19 @@
 #define _SAFE_STRING_UTILITY_CONCATENATE_H_
 
 #include "types/types.h"
+#include "universal/error.h"
 
 
+/*!
+ * @brief Concatenates a limited amount of characters from one string to another
+ * without touching the error variable
+ * @param str1 destination string
+ * @param str2 source string
+ * @param limit maximum amount of characters to concatenate
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_concatenate_limit_r(s_string_t, s_string_t, unsigned long int);
+
 /*!
  * @brief Concatenates a limited amount of characters from one string to another
  * @param str1 destination string
@@ -45,6 +56,14 @@
  */
 void safe_string_concatenate_limit(s_string_t, s_string_t, unsigned long int);
 
+/*!
+ * @brief Concatenates one string to another without touching the error variable
+ * @param str1 destination string
+ * @param str2 source string
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_concatenate_r(s_string_t, s_string_t);
+
 /*!
  * @brief Concatenates one string to another
  * @param str1 destination string
@@ -30,7 +30,6 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdlib.h>
 #include "types/types.h"
 #include "universal.h"
 #include "utility.h"
@@ -38,59 +37,66 @@
 
 /*!
  * @brief Copies a limited amount of characters from one string to another
+ * without touching the error variable
  * @param str1 destination string
  * @param str2 source string
  * @param length maximum amount of characters to copy
- * @note Sets the error variable indicating success or failure
+ * @return Error code indicating success or failure
  */
-void safe_string_copy_limit(s_string_t str1, s_string_t str2, unsigned long int length)
+s_string_error_t safe_string_copy_limit_r(s_string_t str1, s_string_t str2, unsigned long int length)
 {
 	if(safe_string_valid(str1) && safe_string_valid(str2)) {
-		unsigned long int i = 0;
-		length = MIN(length, safe_string_length(str2));
-		
-		if(safe_string_length(str1) != length) {
-			char *new_string;
-			new_string = (char *)realloc(str1->s_string, (length + 1) * sizeof(char));
-			
-			if(!new_string) {
-				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-				return;
-			} else {
-				str1->s_string = new_string;
-			}
-		}
+		s_string_error_t error = SAFE_STRING_ERROR_NO_ERROR;
 
-		for(i = 0; i < length; i++) {
-			safe_string_index_set(str1, i, safe_string_index(str2, i));
-		}
+		length = MIN(length, str2->s_length - 1);
 
-		safe_string_index_set(str1, i, '\0');
-		
-		str1->s_length = length + 1;
+		if((error = _safe_string_grow_r(str1, length + 1)) == SAFE_STRING_ERROR_NO_ERROR) {
+			_safe_string_range_copy(str1->s_string, str2->s_string, length);
+			str1->s_string[length] = '\0';
+			str1->s_length = length + 1;
+			_safe_string_stats_copy(length);
+		}
 
-		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-		return;
+		return(error);
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return;
+		return(SAFE_STRING_ERROR_NULL_POINTER);
 	}
 }
 
 /*!
- * @brief Copies from one string to another
+ * @brief Copies a limited amount of characters from one string to another
  * @param str1 destination string
  * @param str2 source string
+ * @param length maximum amount of characters to copy
  * @note Sets the error variable indicating success or failure
  */
-void safe_string_copy(s_string_t str1, s_string_t str2)
+void safe_string_copy_limit(s_string_t str1, s_string_t str2, unsigned long int length)
+{
+	safe_string_set_error(safe_string_copy_limit_r(str1, str2, length));
+}
+
+/*!
+ * @brief Copies from one string to another without touching the error variable
+ * @param str1 destination string
+ * @param str2 source string
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_copy_r(s_string_t str1, s_string_t str2)
 {
 	if(safe_string_valid(str1) && safe_string_valid(str2)) {
-		safe_string_copy_limit(str1, str2, safe_string_length(str2));
-		return;
+		return(safe_string_copy_limit_r(str1, str2, str2->s_length - 1));
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return;
+		return(SAFE_STRING_ERROR_NULL_POINTER);
 	}
 }
 
+/*!
+ * @brief Copies from one string to another
+ * @param str1 destination string
+ * @param str2 source string
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_copy(s_string_t str1, s_string_t str2)
+{
+	safe_string_set_error(safe_string_copy_r(str1, str2));
+}
@@ -34,6 +34,17 @@
 #define _SAFE_STRING_UTILITY_COPY_H_
 
 #include "types/types.h"
+#include "universal/error.h"
+
+/*!
+ * @brief Copies a limited amount of characters from one string to another
+ * without touching the error variable
+ * @param str1 destination string
+ * @param str2 source string
+ * @param length maximum amount of characters to copy
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_copy_limit_r(s_string_t, s_string_t, unsigned long int);
 
 /*!
  * @brief Copies a limited amount of characters from one string to another
@@ -44,6 +55,14 @@
  */
 void safe_string_copy_limit(s_string_t, s_string_t, unsigned long int);
 
+/*!
+ * @brief Copies from one string to another without touching the error variable
+ * @param str1 destination string
+ * @param str2 source string
+ * @return Error code indicating success or failure
+ */
+s_string_error_t safe_string_copy_r(s_string_t, s_string_t);
+
 /*!
  * @brief Copies from one string to another
  * @param str1 destination string
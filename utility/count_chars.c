@@ -43,19 +43,20 @@
  * @param mode for valid modes see the s_string_count_chars_mode_t definition
  * @param count address of the variable to store the amount of elements in the returned array
  * @return Array containing frequencies of characters specified by the mode
+ * @note The array must be released with safe_string_free
  * @note Sets the error variable indicating success or failure
  */
 unsigned long int *_safe_string_count_chars_freqs(s_string_t str, s_string_count_chars_mode_t mode, unsigned long int *count)
 {
 	if(_S_COUNT_CHARS_MODE_FREQS(mode)) {
 		if(safe_string_valid(str) && count) {
-			unsigned long int *counts = (unsigned long int *)calloc(S_CHARSET_LIMIT, sizeof(unsigned long int));
+			unsigned long int *counts = (unsigned long int *)_safe_string_calloc(S_CHARSET_LIMIT, sizeof(unsigned long int));
 
 			if(counts) {
 				unsigned long int i = 0;
 
-				for(i = 0; i < safe_string_length(str); i++) {
-					counts[safe_string_index(str, i)]++;
+				for(i = 0; i < str->s_length - 1; i++) {
+					counts[(unsigned char)str->s_string[i]]++;
 				}
 				
 				switch(mode) {
@@ -67,7 +68,7 @@ unsigned long int *_safe_string_count_chars_freqs(s_string_t str, s_string_count
 					default:
 						/* some strange error */
 						safe_string_set_error(SAFE_STRING_ERROR_BAD_VALUE);
-						free(counts);
+						_safe_string_free(counts);
 						*count = SAFE_STRING_EMPTY;
 						return(SAFE_STRING_INVALID);
 						break;
@@ -92,20 +93,21 @@ unsigned long int *_safe_string_count_chars_freqs(s_string_t str, s_string_count
  * @param mode for valid modes see the s_string_count_chars_mode_t definition
  * @param count address of the variable to store the amount of elements in the returned array
  * @return Array containing characters from the string specified by the mode
+ * @note The array must be released with safe_string_free
  * @note Sets the error variable indicating success or failure
  */
 char *_safe_string_count_chars_chars(s_string_t str, s_string_count_chars_mode_t mode, unsigned long int *count)
 {
 	if(_S_COUNT_CHARS_MODE_CHARS(mode)) {
 		if(safe_string_valid(str) && count) {
-			char *rcounts = (char *)calloc(S_CHARSET_LIMIT, sizeof(char));
-			unsigned long int *counts = (unsigned long int *)calloc(S_CHARSET_LIMIT, sizeof(unsigned long int));
+			char *rcounts = (char *)_safe_string_calloc(S_CHARSET_LIMIT, sizeof(char));
+			unsigned long int *counts = (unsigned long int *)_safe_string_calloc(S_CHARSET_LIMIT, sizeof(unsigned long int));
 
 			if(counts && rcounts) {
 				unsigned long int i = 0, j = 0;
 
-				for(i = 0; i < safe_string_length(str); i++) {
-					counts[safe_string_index(str, i)]++;
+				for(i = 0; i < str->s_length - 1; i++) {
+					counts[(unsigned char)str->s_string[i]]++;
 				}
 
 				switch(mode) {
@@ -140,21 +142,23 @@ char *_safe_string_count_chars_chars(s_string_t str, s_string_count_chars_mode_t
 					default:
 						/* some strange error */
 						safe_string_set_error(SAFE_STRING_ERROR_BAD_VALUE);
-						free(counts);
+						_safe_string_free(counts);
 						*count = SAFE_STRING_EMPTY;
 						return(SAFE_STRING_INVALID);
 						break;
 				}
 
-				if(!j || realloc(rcounts, j * sizeof(char))) {
+				char *shrunk = j ? (char *)_safe_string_realloc(rcounts, j * sizeof(char)) : rcounts;
+
+				if(shrunk) {
 					safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-					free(counts);
+					_safe_string_free(counts);
 					*count = j;
-					return(rcounts);
+					return(shrunk);
 				} else {
 					safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-					free(counts);
-					free(rcounts);
+					_safe_string_free(counts);
+					_safe_string_free(rcounts);
 					*count = SAFE_STRING_EMPTY;
 					return(SAFE_STRING_INVALID);
 				}
@@ -61,6 +61,7 @@ typedef enum { \
  * @param mode for valid modes see the s_string_count_chars_mode_t definition
  * @param count address of the variable to store the amount of elements in the returned array
  * @return Array containing frequencies of characters specified by the mode
+ * @note The array must be released with safe_string_free
  * @note Sets the error variable indicating success or failure
  */
 extern unsigned long int *_safe_string_count_chars_freqs(s_string_t str, s_string_count_chars_mode_t mode, unsigned long int *count);
@@ -71,6 +72,7 @@ extern unsigned long int *_safe_string_count_chars_freqs(s_string_t str, s_strin
  * @param mode for valid modes see the s_string_count_chars_mode_t definition
  * @param count address of the variable to store the amount of elements in the returned array
  * @return Array containing characters from the string specified by the mode
+ * @note The array must be released with safe_string_free
  * @note Sets the error variable indicating success or failure
  */
 extern char *_safe_string_count_chars_chars(s_string_t str, s_string_count_chars_mode_t mode, unsigned long int *count);
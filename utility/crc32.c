@@ -57,7 +57,7 @@ uint32_t _safe_string_crc32_reflect_bits(uint32_t value, uint32_t bits)
 
 	for(i = 0; i < bits; i++, value >>= 1) {
 		if(value & 1) {
-			output |= 1 << (bits - (i + 1));
+			output |= 1u << (bits - (i + 1));
 		}
 	}
 
@@ -71,7 +71,7 @@ uint32_t _safe_string_crc32_reflect_bits(uint32_t value, uint32_t bits)
 void _safe_string_crc32_lookup_table_generate(void)
 {
 	if(!_s_crc32_lookup_table) {
-		_s_crc32_lookup_table = (uint32_t *)calloc(S_CHARSET_LIMIT, sizeof(uint32_t));
+		_s_crc32_lookup_table = (uint32_t *)_safe_string_calloc(S_CHARSET_LIMIT, sizeof(uint32_t));
 
 		if(_s_crc32_lookup_table) {
 			uint32_t i = 0, j = 0;
@@ -98,7 +98,8 @@ void _safe_string_crc32_lookup_table_generate(void)
 void safe_string_crc32_delete(void)
 {
 	if(_s_crc32_lookup_table) {
-		free(_s_crc32_lookup_table);
+		_safe_string_free(_s_crc32_lookup_table);
+		_s_crc32_lookup_table = SAFE_STRING_INVALID;
 	}
 }
 
@@ -118,10 +119,50 @@ uint32_t safe_string_crc32(s_string_t str)
 	}
 
 	if(safe_string_valid(str)) {
-		uint32_t crc = 0xFFFFFFFF, i = 0;
+		const unsigned char *data = (const unsigned char *)str->s_string;
+		unsigned long int i = 0, length = str->s_length - 1;
+		uint32_t crc = 0xFFFFFFFF;
 
-		for(i = 0; i < safe_string_length(str); i++) {
-			crc = (crc >> _S_8BIT) ^ _s_crc32_lookup_table[(crc & 0xFF) ^ (unsigned char)safe_string_index(str, i)];
+		for(i = 0; i < length; i++) {
+			crc = (crc >> _S_8BIT) ^ _s_crc32_lookup_table[(crc & 0xFF) ^ data[i]];
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(crc ^ 0xFFFFFFFF);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Generates the CRC32 checksum of a given rope, chunk by chunk without
+ * flattening it
+ * @param rope the source rope
+ * @return The CRC32 checksum calculated from the given rope
+ * @note Sets the error variable indicating success or failure
+ */
+uint32_t safe_string_rope_crc32(safe_string_rope_t rope)
+{
+	if(!_s_crc32_lookup_table) {
+		_safe_string_crc32_lookup_table_generate();
+		if(safe_string_error()) {
+			return(SAFE_STRING_EMPTY);
+		}
+	}
+
+	if(rope) {
+		uint32_t crc = 0xFFFFFFFF;
+		s_string_rope_iterator_t iterator;
+		s_string_view_t chunk;
+		unsigned long int i = 0;
+
+		safe_string_rope_iterator(rope, &iterator);
+
+		while(safe_string_rope_iterator_next(&iterator, &chunk)) {
+			for(i = 0; i < chunk.v_length; i++) {
+				crc = (crc >> _S_8BIT) ^ _s_crc32_lookup_table[(crc & 0xFF) ^ (unsigned char)chunk.v_string[i]];
+			}
 		}
 
 		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
@@ -36,25 +36,43 @@
 #include "macro.h"
 
 /*!
- * @brief Creates a duplicate of a valid safe string.
+ * @brief Creates a duplicate of a valid safe string, allocating it from an arena.
+ * @param arena arena to allocate the duplicate from (if SAFE_STRING_INVALID then
+ * the heap is used)
  * @param source string
  * @return A valid safe string given there were no errors in the input or processing
  * otherwise SAFE_STRING_INVALID.
  * @note Sets the error value indicating success or failure.
+ * @note The duplicate stores it's structure and contents in a single block,
+ * unless allocated from the heap (see safe_string_duplicate).
  */
-s_string_t safe_string_duplicate(s_string_t str)
+s_string_t safe_string_duplicate_in(safe_string_arena_t arena, s_string_t str)
 {
 	if(safe_string_valid(str)) {
-		char *retn = safe_string_access_characters(str);
-
-		if(!safe_string_error()) {
-			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-			return(safe_string_new(retn));
-		} else {
-			return(SAFE_STRING_INVALID);
+		if(!arena && !(str->s_flags & (_S_STRING_FLAG_UNMANAGED | _S_STRING_FLAG_MAPPED)) && str->s_length > SAFE_STRING_INLINE_SIZE) {
+			return(_safe_string_share(str)); /* use the error code from _safe_string_share */
 		}
+
+		return(_safe_string_allocate_copy_in(arena, str->s_string, safe_string_length(str))); /* use the error code from _safe_string_allocate_copy_in */
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
 		return(SAFE_STRING_INVALID);
 	}
 }
+
+/*!
+ * @brief Creates a duplicate of a valid safe string.
+ * @param source string
+ * @return A valid safe string given there were no errors in the input or processing
+ * otherwise SAFE_STRING_INVALID.
+ * @note Sets the error value indicating success or failure.
+ * @note Strings too long to be stored inline share the source's reference
+ * counted buffer rather than copying it, the buffer is copied when either string
+ * is first modified. The first duplicate of a string moves it into a shared
+ * buffer so must not race with other uses of the source, later duplicates may
+ * be made from any thread.
+ */
+s_string_t safe_string_duplicate(s_string_t str)
+{
+	return(safe_string_duplicate_in(SAFE_STRING_INVALID, str));
+}
@@ -41,7 +41,25 @@
  * @return A valid safe string given there were no errors in the input or processing
  * otherwise SAFE_STRING_INVALID.
  * @note Sets the error value indicating success or failure.
+ * @note Strings too long to be stored inline share the source's reference
+ * counted buffer rather than copying it, the buffer is copied when either string
+ * is first modified. The first duplicate of a string moves it into a shared
+ * buffer so must not race with other uses of the source, later duplicates may
+ * be made from any thread.
  */
 extern s_string_t safe_string_duplicate(s_string_t);
 
+/*!
+ * @brief Creates a duplicate of a valid safe string, allocating it from an arena.
+ * @param arena arena to allocate the duplicate from (if SAFE_STRING_INVALID then
+ * the heap is used)
+ * @param source string
+ * @return A valid safe string given there were no errors in the input or processing
+ * otherwise SAFE_STRING_INVALID.
+ * @note Sets the error value indicating success or failure.
+ * @note The duplicate stores it's structure and contents in a single block,
+ * unless allocated from the heap (see safe_string_duplicate).
+ */
+extern s_string_t safe_string_duplicate_in(safe_string_arena_t, s_string_t);
+
 #endif
@@ -59,12 +59,20 @@ s_string_t safe_string_filter_printable(s_string_t str)
 s_string_t safe_string_filter_generic(s_string_t str, int(*filter)(int), const char c)
 {
 	if(safe_string_valid(str)) {
-		unsigned long int i = 0;
+		unsigned long int i = 0, length = str->s_length - 1;
 
-		for(i = 0; i < safe_string_length(str); i++) {
-			safe_string_index_set(str, i, (*filter)(safe_string_index(str, i)) ? safe_string_index(str, i) : c);
+		if(!_safe_string_unshare(str)) {
+			safe_string_set_error(_safe_string_modify_error(str));
+			return(SAFE_STRING_INVALID);
 		}
 
+		for(i = 0; i < length; i++) {
+			if(!(*filter)((unsigned char)str->s_string[i])) {
+				str->s_string[i] = c;
+			}
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 		return(str);
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
@@ -35,6 +35,32 @@
 #include "utility.h"
 #include "macro.h"
 
+/*!
+ * @brief Obtains the element at a given string index without touching the error
+ * variable
+ * @param str source string
+ * @param index element index to access
+ * @param c stores the element if the index is valid, otherwise a NULL value
+ * @return Error code indicating success or failure
+ */
+s_string_error_t (safe_string_index_r)(const s_string_t str, unsigned long int index, unsigned char *c)
+{
+	if(!c) {
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	} else if(safe_string_valid(str)) {
+		if(index > str->s_length - 1) {
+			*c = '\0';
+			return(SAFE_STRING_ERROR_INDEX_BOUNDS);
+		} else {
+			*c = str->s_string[index];
+			return(SAFE_STRING_ERROR_NO_ERROR);
+		}
+	} else {
+		*c = '\0';
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
 /*!
  * @brief Obtains the element at a given string index
  * @param str source string
@@ -43,19 +69,35 @@
  * a NULL value is returned
  * @note Sets the error variable indicating success or failure
  */
-unsigned char safe_string_index(const s_string_t str, unsigned long int index)
+unsigned char (safe_string_index)(const s_string_t str, unsigned long int index)
+{
+	unsigned char c = '\0';
+
+	safe_string_set_error(safe_string_index_r(str, index, &c));
+	return(c);
+}
+
+/*!
+ * @brief Sets the element at a given string index without touching the error
+ * variable
+ * @param str destination string
+ * @param index element index to set
+ * @param c value to assign the element
+ * @return Error code indicating success or failure
+ */
+s_string_error_t (safe_string_index_set_r)(s_string_t str, unsigned long int index, const char c)
 {
 	if(safe_string_valid(str)) {
-		if(index < 0 || index > safe_string_length(str)) {
-			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
-			return('\0');
+		if(index > str->s_length - 1) {
+			return(SAFE_STRING_ERROR_INDEX_BOUNDS);
+		} else if(!_safe_string_unshare(str)) {
+			return(_safe_string_modify_error(str));
 		} else {
-			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-			return(str->s_string[index]);
+			str->s_string[index] = c;
+			return(SAFE_STRING_ERROR_NO_ERROR);
 		}
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return('\0');
+		return(SAFE_STRING_ERROR_NULL_POINTER);
 	}
 }
 
@@ -66,19 +108,7 @@ unsigned char safe_string_index(const s_string_t str, unsigned long int index)
  * @param c value to assign the element
  * @note Sets the error variable indicating success or failure
  */
-void safe_string_index_set(s_string_t str, unsigned long int index, const char c)
+void (safe_string_index_set)(s_string_t str, unsigned long int index, const char c)
 {
-	if(safe_string_valid(str)) {
-		if(index < 0 || index > safe_string_length(str)) {
-			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
-			return;
-		} else {
-			str->s_string[index] = c;
-			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-			return;
-		}
-	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return;
-	}
+	safe_string_set_error(safe_string_index_set_r(str, index, c));
 }
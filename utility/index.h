@@ -35,6 +35,17 @@
 #define _SAFE_STRING_UTILITY_INDEX_H_
 
 #include "types/types.h"
+#include "universal/error.h"
+
+/*!
+ * @brief Obtains the element at a given string index without touching the error
+ * variable
+ * @param str source string
+ * @param index element index to access
+ * @param c stores the element if the index is valid, otherwise a NULL value
+ * @return Error code indicating success or failure
+ */
+extern s_string_error_t safe_string_index_r(const s_string_t, unsigned long int, unsigned char *);
 
 /*!
  * @brief Obtains the element at a given string index
@@ -46,6 +57,16 @@
  */
 extern unsigned char safe_string_index(const s_string_t, unsigned long int);
 
+/*!
+ * @brief Sets the element at a given string index without touching the error
+ * variable
+ * @param str destination string
+ * @param index element index to set
+ * @param c value to assign the element
+ * @return Error code indicating success or failure
+ */
+extern s_string_error_t safe_string_index_set_r(s_string_t, unsigned long int, const char);
+
 /*!
  * @brief Sets the element at a given string index
  * @param str destination string
@@ -55,4 +76,62 @@ extern unsigned char safe_string_index(const s_string_t, unsigned long int);
  */
 extern void safe_string_index_set(s_string_t, unsigned long int, const char);
 
+#ifdef SAFE_STRING_INLINE
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_index_r, leaving errors to the
+ * library
+ */
+static inline s_string_error_t _safe_string_index_r_inline(const s_string_t str, unsigned long int index, unsigned char *c)
+{
+	if(c && safe_string_valid(str) && index < str->s_length) {
+		*c = str->s_string[index];
+		return(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		return((safe_string_index_r)(str, index, c));
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_index, leaving errors to the
+ * library
+ */
+static inline unsigned char _safe_string_index_inline(const s_string_t str, unsigned long int index)
+{
+	if(safe_string_valid(str) && index < str->s_length) {
+		_safe_string_error = SAFE_STRING_ERROR_NO_ERROR;
+		return(str->s_string[index]);
+	} else {
+		return((safe_string_index)(str, index));
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_index_set_r, leaving errors
+ * and strings which have to be copied before being modified to the library
+ */
+static inline s_string_error_t _safe_string_index_set_r_inline(s_string_t str, unsigned long int index, const char c)
+{
+	if(safe_string_valid(str) && index < str->s_length && !(str->s_flags & (_S_STRING_FLAG_FOREIGN | _S_STRING_FLAG_LITERAL))) {
+		str->s_string[index] = c;
+		return(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		return((safe_string_index_set_r)(str, index, c));
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_index_set, leaving errors and
+ * strings which have to be copied before being modified to the library
+ */
+static inline void _safe_string_index_set_inline(s_string_t str, unsigned long int index, const char c)
+{
+	_safe_string_error = _safe_string_index_set_r_inline(str, index, c);
+}
+
+#define safe_string_index_r(str, index, c) _safe_string_index_r_inline(str, index, c)
+#define safe_string_index(str, index) _safe_string_index_inline(str, index)
+#define safe_string_index_set_r(str, index, c) _safe_string_index_set_r_inline(str, index, c)
+#define safe_string_index_set(str, index, c) _safe_string_index_set_inline(str, index, c)
+#endif
+
 #endif
@@ -36,6 +36,43 @@
 #include "universal.h"
 #include "macro.h"
 
+/*!
+ * @brief (INTERNAL) Validates and sorts the indexes a string is to be split at
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @return Boolean value of true if the indexes are valid, else false
+ * @note Sets the error variable indicating success or failure
+ */
+static int _safe_string_index_split_sort(s_string_t str, unsigned long int *indexes, unsigned long int index_count)
+{
+	unsigned long int i = 0, length = safe_string_length(str), temp = 0, swapped = 1;
+
+	/* validate the indexes */
+	for(i = 0; i < index_count; i++) {
+		if(indexes[i] >= length) {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_EMPTY);
+		}
+	}
+
+	/* sort the indexes */
+	while(swapped) {
+		swapped = 0;
+		for(i = 1; i < index_count; i++) {
+			if(indexes[i] < indexes[i - 1]) {
+				temp = indexes[i];
+				indexes[i] = indexes[i - 1];
+				indexes[i - 1] = temp;
+				swapped = 1;
+			}
+		}
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	return(!SAFE_STRING_EMPTY);
+}
+
 /*!
  * @brief Splits a string based upon a list of indexes.
  * @param str source string
@@ -49,45 +86,33 @@
 s_strings_t safe_string_index_split(s_string_t str, unsigned long int *indexes, unsigned long int index_count, unsigned long int *count)
 {
 	if(safe_string_valid(str) && indexes && count) {
-		unsigned long int i = 0, j = 0, length = safe_string_length(str), temp = 0, swapped = 1;
+		unsigned long int i = 0, j = 0;
 
-		/* validate the indexes */
-		for(i = 0; i < index_count; i++) {
-			if(indexes[i] >= length) {
-				safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
-				return(SAFE_STRING_INVALID);
-			}
-		}
-
-		/* sort the indexes */
-		while(swapped) {
-			swapped = 0;
-			for(i = 1; i < index_count; i++) {
-				if(indexes[i] < indexes[i - 1]) {
-					temp = indexes[i];
-					indexes[i] = indexes[i - 1];
-					indexes[i - 1] = temp;
-					swapped = 1;
-				}
-			}
+		if(!_safe_string_index_split_sort(str, indexes, index_count)) {
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_string_index_split_sort */
 		}
 
-		s_strings_t retn = (s_strings_t)calloc(index_count + 2, sizeof(s_string_t)); /* maximum size */
+		s_strings_t retn = (s_strings_t)_safe_string_calloc(index_count + 2, sizeof(s_string_t)); /* maximum size */
 
 		if(retn) {
+			_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, (index_count + 2) * sizeof(s_string_t));
+
 			for(i = 0, j = 0; i < index_count; i++, j = indexes[i - 1]) {
 				retn[i] = safe_string_substring(str, j, indexes[i]);
 			}
 			
 			retn[i++] = safe_string_substring(str, j, safe_string_length(str)); /* always needed */
 			
-			if(realloc(retn, i * sizeof(s_string_t))) {
+			s_strings_t shrunk = (s_strings_t)_safe_string_realloc(retn, i * sizeof(s_string_t));
+
+			if(shrunk) {
 				*count = i;
 				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-				return(retn);
+				return(shrunk);
 			} else {
 				*count = SAFE_STRING_EMPTY;
-				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+				safe_string_array_delete(retn, i);
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 				return(SAFE_STRING_INVALID);
 			}
 		} else {
@@ -99,3 +124,100 @@ s_strings_t safe_string_index_split(s_string_t str, unsigned long int *indexes,
 		return(SAFE_STRING_INVALID);
 	}
 }
+
+/*!
+ * @brief Splits a string based upon a list of indexes, packing the result into a
+ * single allocation.
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @return Packed array of strings split by the given indexes, or
+ * SAFE_STRING_INVALID if an error was detected.
+ * @note The index array will be sorted upon return.
+ */
+s_strings_packed_t safe_string_index_split_packed(s_string_t str, unsigned long int *indexes, unsigned long int index_count)
+{
+	if(safe_string_valid(str) && indexes) {
+		unsigned long int i = 0, j = 0;
+		s_strings_packed_t retn;
+
+		if(!_safe_string_index_split_sort(str, indexes, index_count)) {
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_string_index_split_sort */
+		}
+
+		retn = _safe_strings_packed_allocate(index_count + 1, safe_string_length(str));
+
+		if(retn) {
+			for(i = 0, j = 0; i < index_count; j = indexes[i++]) {
+				_safe_strings_packed_append(retn, str->s_string + j, indexes[i] - j, SAFE_STRING_INVALID, 0);
+			}
+
+			_safe_strings_packed_append(retn, str->s_string + j, safe_string_length(str) - j, SAFE_STRING_INVALID, 0); /* always needed */
+		}
+
+		return(retn); /* use the error code from _safe_strings_packed_allocate */
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Splits a string based upon a list of indexes, without copying.
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @param count the amount of views returned
+ * @return Array of views referring to the ranges split by the given indexes, to
+ * be released with safe_string_free, or SAFE_STRING_INVALID if an error was
+ * detected.
+ * @note The index array will be sorted upon return.
+ */
+s_string_view_t *safe_string_index_split_view(s_string_t str, unsigned long int *indexes, unsigned long int index_count, unsigned long int *count)
+{
+	if(safe_string_valid(str) && indexes && count) {
+		unsigned long int i = 0, j = 0;
+		s_string_view_t *retn;
+
+		if(!_safe_string_index_split_sort(str, indexes, index_count)) {
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_string_index_split_sort */
+		}
+
+		if(!(retn = (s_string_view_t *)_safe_string_malloc((index_count + 1) * sizeof(s_string_view_t)))) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_INVALID);
+		}
+
+		_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, (index_count + 1) * sizeof(s_string_view_t));
+
+		for(i = 0, j = 0; i < index_count; j = indexes[i++]) {
+			retn[i] = _safe_string_view_make(str->s_string + j, indexes[i] - j);
+		}
+
+		retn[i++] = _safe_string_view_make(str->s_string + j, safe_string_length(str) - j); /* always needed */
+
+		*count = i;
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Splits a string into a vector based upon a list of indexes.
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @return Vector of strings split by the given indexes, or SAFE_STRING_INVALID
+ * if an error was detected.
+ * @note The index array will be sorted upon return.
+ */
+safe_strings_vec_t safe_string_index_split_vec(s_string_t str, unsigned long int *indexes, unsigned long int index_count)
+{
+	unsigned long int count = 0;
+	s_strings_t strs = safe_string_index_split(str, indexes, index_count, &count);
+
+	return(_safe_strings_vec_adopt(strs, count));
+}
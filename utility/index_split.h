@@ -46,4 +46,40 @@
  */
 extern s_strings_t safe_string_index_split(s_string_t, unsigned long int *, unsigned long int, unsigned long int *);
 
+/*!
+ * @brief Splits a string based upon a list of indexes, packing the result into a
+ * single allocation.
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @return Packed array of strings split by the given indexes, or
+ * SAFE_STRING_INVALID if an error was detected.
+ * @note The index array will be sorted upon return.
+ */
+extern s_strings_packed_t safe_string_index_split_packed(s_string_t, unsigned long int *, unsigned long int);
+
+/*!
+ * @brief Splits a string based upon a list of indexes, without copying.
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @param count the amount of views returned
+ * @return Array of views referring to the ranges split by the given indexes, to
+ * be released with safe_string_free, or SAFE_STRING_INVALID if an error was
+ * detected.
+ * @note The index array will be sorted upon return.
+ */
+extern s_string_view_t *safe_string_index_split_view(s_string_t, unsigned long int *, unsigned long int, unsigned long int *);
+
+/*!
+ * @brief Splits a string into a vector based upon a list of indexes.
+ * @param str source string
+ * @param indexes array of indexes indicating offsets to split at
+ * @param index_count the amount of indexes specified
+ * @return Vector of strings split by the given indexes, or SAFE_STRING_INVALID
+ * if an error was detected.
+ * @note The index array will be sorted upon return.
+ */
+extern safe_strings_vec_t safe_string_index_split_vec(s_string_t, unsigned long int *, unsigned long int);
+
 #endif
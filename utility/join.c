@@ -31,35 +31,132 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <string.h> /* memcpy */
 #include "types/types.h"
 #include "universal.h"
 #include "utility.h"
 #include "macro.h"
 
-s_string_t safe_string_join_limit(s_strings_t strs, unsigned long int count, s_string_t delim, unsigned long int limit)
+/*!
+ * @brief (INTERNAL) Joins strings already known to be valid, without visiting
+ * the array an extra time to validate it
+ * @param arena arena to allocate from (if SAFE_STRING_INVALID then the string
+ * is allocated from the heap)
+ * @param strs array of valid strings
+ * @param count amount of strings within the array
+ * @param delim valid delimeter placed between each string
+ * @param limit maximum amount of strings to join
+ * @return The joined string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+static s_string_t _safe_string_join_valid(safe_string_arena_t arena, s_strings_t strs, unsigned long int count, s_string_t delim, unsigned long int limit)
+{
+	if(count && limit) {
+		unsigned long int i = 0, length = 0;
+		s_string_t retn;
+
+		limit = MIN(limit, count);
+
+		for(i = 0; i < limit; i++) {
+			length += safe_string_length(strs[i]);
+		}
+		length += (limit - 1) * safe_string_length(delim);
+
+		retn = _safe_string_allocate_in(arena, length);
+
+		if(retn) {
+			retn->s_length = 1; /* start out empty, the buffer already fits the result */
+
+			for(i = 0; i < limit - 1; i++) {
+				safe_string_concatenate(retn, strs[i]);
+				safe_string_concatenate(retn, delim);
+			}
+
+			safe_string_concatenate(retn, strs[i]);
+
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(retn);
+		} else {
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_string_allocate_in */
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+s_string_t safe_string_join_limit_in(safe_string_arena_t arena, s_strings_t strs, unsigned long int count, s_string_t delim, unsigned long int limit)
 {
 	if(safe_strings_valid(strs, count) && safe_string_valid(delim)) {
-		if(count && limit) {
-			unsigned int i = 0;
-			s_string_t retn = safe_string_new("");
+		return(_safe_string_join_valid(arena, strs, count, delim, limit));
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+s_string_t (safe_string_join_limit)(s_strings_t strs, unsigned long int count, s_string_t delim, unsigned long int limit)
+{
+	return(safe_string_join_limit_in(SAFE_STRING_INVALID, strs, count, delim, limit));
+}
 
-			limit = MIN(limit, count);
+s_string_t safe_string_join_in(safe_string_arena_t arena, s_strings_t strs, unsigned long int count, s_string_t delim)
+{
+	return(safe_string_join_limit_in(arena, strs, count, delim, count));
+}
 
-			if(!safe_string_error()) {
-				for(i = 0; i < limit - 1; i++) {
-					safe_string_concatenate(retn, strs[i]);
-					safe_string_concatenate(retn, delim);
+s_string_t (safe_string_join)(s_strings_t strs, unsigned long int count, s_string_t delim)
+{
+	return(safe_string_join_limit(strs, count, delim, count));
+}
+
+s_string_t safe_string_join_limit_char(s_strings_t strs, unsigned long int count, const char *delim, unsigned long int limit)
+{
+	_s_string_t temp;
+
+	return(safe_string_join_limit(strs, count, _safe_string_wrap(&temp, delim), limit));
+}
+
+s_string_t safe_string_join_char(s_strings_t strs, unsigned long int count, const char *delim)
+{
+	return(safe_string_join_limit_char(strs, count, delim, count));
+}
+
+s_string_t safe_string_join_packed_limit(s_strings_packed_t packed, s_string_t delim, unsigned long int limit)
+{
+	if(packed && safe_string_valid(delim)) {
+		if(packed->count && limit) {
+			unsigned long int i = 0, length = 0, delim_length = safe_string_length(delim);
+			s_string_t retn;
+
+			limit = MIN(limit, packed->count);
+
+			for(i = 0; i < limit; i++) {
+				length += packed->entries[i].length;
+			}
+			length += (limit - 1) * delim_length;
+
+			retn = _safe_string_allocate(length);
+
+			if(retn) {
+				char *dest = retn->s_string;
+
+				for(i = 0; i < limit; i++) {
+					if(i) {
+						memcpy(dest, delim->s_string, delim_length);
+						dest += delim_length;
+					}
+
+					memcpy(dest, packed->data + packed->entries[i].offset, packed->entries[i].length);
+					dest += packed->entries[i].length;
 				}
 
-				safe_string_concatenate(retn, strs[i]);
+				_safe_string_stats_copy(length);
 
 				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 				return(retn);
 			} else {
-				if(safe_string_valid(retn)) {
-					safe_string_delete(retn);
-				}
-				return(SAFE_STRING_INVALID);
+				return(SAFE_STRING_INVALID); /* use the error code from _safe_string_allocate */
 			}
 		} else {
 			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
@@ -71,23 +168,22 @@ s_string_t safe_string_join_limit(s_strings_t strs, unsigned long int count, s_s
 	}
 }
 
-
-s_string_t safe_string_join(s_strings_t strs, unsigned long int count, s_string_t delim)
+s_string_t safe_string_join_packed(s_strings_packed_t packed, s_string_t delim)
 {
-	return(safe_string_join_limit(strs, count, delim, count));
+	return(safe_string_join_packed_limit(packed, delim, packed ? packed->count : 0));
 }
 
-s_string_t safe_string_join_limit_char(s_strings_t strs, unsigned long int count, const char *delim, unsigned long int limit)
+s_string_t safe_string_join_vec_limit(safe_strings_vec_t vec, s_string_t delim, unsigned long int limit)
 {
-	s_string_t temp = safe_string_new(delim);
-	s_string_t retn = safe_string_join_limit(strs, count, temp, limit);
-	s_string_error_t error = safe_string_error_val();
-	safe_string_delete(temp);
-	safe_string_set_error(error);
-	return(retn);
+	if(safe_strings_vec_valid(vec) && safe_string_valid(delim)) {
+		return(_safe_string_join_valid(SAFE_STRING_INVALID, vec->v_strings, vec->v_count, delim, limit)); /* the vector tracks the validity of it's strings */
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
 }
 
-s_string_t safe_string_join_char(s_strings_t strs, unsigned long int count, const char *delim)
+s_string_t safe_string_join_vec(safe_strings_vec_t vec, s_string_t delim)
 {
-	return(safe_string_join_limit_char(strs, count, delim, count));
+	return(safe_string_join_vec_limit(vec, delim, vec ? vec->v_count : 0));
 }
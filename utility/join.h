@@ -41,8 +41,26 @@ s_string_t safe_string_join_limit(s_strings_t, unsigned long int, s_string_t, un
 
 s_string_t safe_string_join(s_strings_t, unsigned long int, s_string_t);
 
+s_string_t safe_string_join_limit_in(safe_string_arena_t, s_strings_t, unsigned long int, s_string_t, unsigned long int);
+
+s_string_t safe_string_join_in(safe_string_arena_t, s_strings_t, unsigned long int, s_string_t);
+
 s_string_t safe_string_join_limit_char(s_strings_t, unsigned long int, const char *, unsigned long int);
 
 s_string_t safe_string_join_char(s_strings_t, unsigned long int, const char *);
 
+s_string_t safe_string_join_packed_limit(s_strings_packed_t, s_string_t, unsigned long int);
+
+s_string_t safe_string_join_packed(s_strings_packed_t, s_string_t);
+
+s_string_t safe_string_join_vec_limit(safe_strings_vec_t, s_string_t, unsigned long int);
+
+s_string_t safe_string_join_vec(safe_strings_vec_t, s_string_t);
+
+#ifdef SAFE_STRING_GENERIC
+#define safe_string_join(strs, count, delim) _safe_string_generic(delim, safe_string_join)(strs, count, delim)
+
+#define safe_string_join_limit(strs, count, delim, limit) _safe_string_generic(delim, safe_string_join_limit)(strs, count, delim, limit)
+#endif
+
 #endif
@@ -35,19 +35,35 @@
 #include "macro.h"
 
 /*!
- * @brief Obtains the length of a string
+ * @brief Obtains the length of a string without touching the error variable
  * @param str source string
- * @return The length of the string (this is not the size of it's buffer)
- * @note Sets the error variable indicating success or failure
+ * @param length stores the length of the string (this is not the size of it's
+ * buffer)
+ * @return Error code indicating success or failure
  */
-unsigned long int safe_string_length(const s_string_t str)
+s_string_error_t (safe_string_length_r)(const s_string_t str, unsigned long int *length)
 {
-	if(safe_string_valid(str)) { /* check for a deleted string */
-		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-		return(str->s_length - 1);
+	if(!length) {
+		return(SAFE_STRING_ERROR_NULL_POINTER);
+	} else if(safe_string_valid(str)) { /* check for a deleted string */
+		*length = str->s_length - 1;
+		return(SAFE_STRING_ERROR_NO_ERROR);
 	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_BAD_VALUE);
-		return(SAFE_STRING_EMPTY);
+		*length = SAFE_STRING_EMPTY;
+		return(SAFE_STRING_ERROR_BAD_VALUE);
 	}
 }
 
+/*!
+ * @brief Obtains the length of a string
+ * @param str source string
+ * @return The length of the string (this is not the size of it's buffer)
+ * @note Sets the error variable indicating success or failure
+ */
+unsigned long int (safe_string_length)(const s_string_t str)
+{
+	unsigned long int length = SAFE_STRING_EMPTY;
+
+	safe_string_set_error(safe_string_length_r(str, &length));
+	return(length);
+}
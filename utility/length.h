@@ -34,6 +34,16 @@
 #define _SAFE_STRING_UTILITY_LENGTH_H_
 
 #include "types/types.h"
+#include "universal/error.h"
+
+/*!
+ * @brief Obtains the length of a string without touching the error variable
+ * @param str source string
+ * @param length stores the length of the string (this is not the size of it's
+ * buffer)
+ * @return Error code indicating success or failure
+ */
+extern s_string_error_t safe_string_length_r(const s_string_t, unsigned long int *);
 
 /*!
  * @brief Obtains the length of a string
@@ -43,4 +53,37 @@
  */
 extern unsigned long int safe_string_length(const s_string_t);
 
+#ifdef SAFE_STRING_INLINE
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_length_r, leaving errors to
+ * the library
+ */
+static inline s_string_error_t _safe_string_length_r_inline(const s_string_t str, unsigned long int *length)
+{
+	if(length && safe_string_valid(str)) {
+		*length = str->s_length - 1;
+		return(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		return((safe_string_length_r)(str, length));
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Inline version of safe_string_length, leaving errors to the
+ * library
+ */
+static inline unsigned long int _safe_string_length_inline(const s_string_t str)
+{
+	if(safe_string_valid(str)) {
+		_safe_string_error = SAFE_STRING_ERROR_NO_ERROR;
+		return(str->s_length - 1);
+	} else {
+		return((safe_string_length)(str));
+	}
+}
+
+#define safe_string_length_r(str, length) _safe_string_length_r_inline(str, length)
+#define safe_string_length(str) _safe_string_length_inline(str)
+#endif
+
 #endif
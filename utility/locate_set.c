@@ -36,30 +36,6 @@
 #include "universal.h"
 #include "macro.h"
 
-/*!
- * @brief Internal function to check if specific character is in a given set
- * @param c character to test for
- * @param set set to test if character is in
- * @return 1 if character is in set, 0 otherwise
- */
-static inline int _char_in_set(char c, s_string_t set)
-{
-	if(safe_string_valid(set)) {
-		unsigned long int i = 0;
-
-		for(i = 0; i < safe_string_length(set); i++) {
-			if(c == safe_string_index(set, i)) {
-				return(1);
-			}
-		}
-		
-		return(0);
-	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return(0);
-	}
-}
-
 /*!
  * @brief Find the first occurrence of a character from a given set within a specified string
  * @param str source string
@@ -68,16 +44,20 @@ static inline int _char_in_set(char c, s_string_t set)
  * source string
  * @return 1 if found, 0 otherwise.
  */
-unsigned long int safe_string_locate_set(s_string_t str, s_string_t sset, unsigned long int *index)
+unsigned long int (safe_string_locate_set)(s_string_t str, s_string_t sset, unsigned long int *index)
 {
 	if(safe_string_valid(str) && safe_string_valid(sset) && index) {
-		unsigned int i = 0;
+		unsigned long int i = 0, length = str->s_length - 1;
+		unsigned char table[_S_RANGE_TABLE_SIZE];
 
-		for(i = 0; i < safe_string_length(str); i++) {
-			if(_char_in_set(safe_string_index(str, i), sset)) {
-				*index = i;
-				return(1);
-			}
+		_safe_string_range_table(table, sset->s_string, sset->s_length - 1);
+		i = _safe_string_range_scan(str->s_string, length, table, 1);
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+
+		if(i < length) {
+			*index = i;
+			return(1);
 		}
 
 		return(0); // index is undefined if not found
@@ -97,8 +77,7 @@ unsigned long int safe_string_locate_set(s_string_t str, s_string_t sset, unsign
  */
 unsigned long int safe_string_locate_set_char(s_string_t str, const char *sset, unsigned long int *index)
 {
-	s_string_t temp = safe_string_new(sset);
-	unsigned long int retn = safe_string_locate_set(str, temp, index);
-	safe_string_delete(temp);
-	return(retn);
+	_s_string_t temp;
+
+	return(safe_string_locate_set(str, _safe_string_wrap(&temp, sset), index));
 }
@@ -56,4 +56,13 @@ extern unsigned long int safe_string_locate_set(s_string_t, s_string_t, unsigned
  */
 extern unsigned long int safe_string_locate_set_char(s_string_t, const char *, unsigned long int *);
 
+#ifdef SAFE_STRING_GENERIC
+/*!
+ * @brief Locates the first character of a string within a set given either as
+ * a string or a C string (dispatched to safe_string_locate_set_char for C
+ * strings, without allocating)
+ */
+#define safe_string_locate_set(str, sset, index) _safe_string_generic(sset, safe_string_locate_set)(str, sset, index)
+#endif
+
 #endif
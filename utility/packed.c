@@ -0,0 +1,176 @@
+/*!
+ * @file utility/packed.c
+ * @brief Implementation of packed string arrays, which store every string in a single allocation
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memcpy */
+#include "types/types.h"
+#include "universal.h"
+#include "utility.h"
+#include "macro.h"
+
+/*!
+ * @brief (INTERNAL) Allocates an empty packed array able to hold 'count' strings
+ * of 'length' characters in total
+ * @param count amount of strings the array will hold
+ * @param length total amount of characters the strings hold (excluding
+ * terminators)
+ * @return The newly created array, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_strings_packed_t _safe_strings_packed_allocate(unsigned long int count, unsigned long int length)
+{
+	unsigned long int table = sizeof(struct _s_strings_packed_t) + count * sizeof(struct _s_strings_packed_entry_t);
+	s_strings_packed_t retn = (s_strings_packed_t)_safe_string_malloc(table + length + count);
+
+	if(retn) {
+		_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, table + length + count);
+		retn->count = SAFE_STRING_EMPTY;
+		retn->size = SAFE_STRING_EMPTY;
+		retn->data = (char *)retn + table;
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+	}
+
+	return(retn);
+}
+
+/*!
+ * @brief (INTERNAL) Appends a string to a packed array, the array must have been
+ * allocated with enough room for it
+ * @param packed destination array
+ * @param str characters to append
+ * @param length amount of characters to append from 'str'
+ * @param suffix characters to append directly after 'str' (can be
+ * SAFE_STRING_INVALID if 'suffix_length' is 0)
+ * @param suffix_length amount of characters to append from 'suffix'
+ */
+void _safe_strings_packed_append(s_strings_packed_t packed, const char *str, unsigned long int length, const char *suffix, unsigned long int suffix_length)
+{
+	struct _s_strings_packed_entry_t *entry = &packed->entries[packed->count++];
+	char *dest = packed->data + packed->size;
+
+	entry->offset = packed->size;
+	entry->length = length + suffix_length;
+
+	if(length) {
+		memcpy(dest, str, length);
+	}
+
+	if(suffix_length) {
+		memcpy(dest + length, suffix, suffix_length);
+	}
+
+	dest[entry->length] = '\0';
+	_safe_string_stats_copy(entry->length);
+
+	packed->size += entry->length + 1;
+}
+
+/*!
+ * @brief Gets the amount of strings within a packed array
+ * @param packed source array
+ * @return The amount of strings, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+unsigned long int safe_strings_packed_count(s_strings_packed_t packed)
+{
+	if(packed) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(packed->count);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Accesses a string within a packed array without copying it
+ * @param packed source array
+ * @param index position of the string within the array
+ * @param length stores the length of the string (can be SAFE_STRING_INVALID)
+ * @return The terminated characters of the string, which remain valid until the
+ * array is deleted, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+const char *safe_strings_packed_index(s_strings_packed_t packed, unsigned long int index, unsigned long int *length)
+{
+	if(packed) {
+		if(index < packed->count) {
+			if(length) {
+				*length = packed->entries[index].length;
+			}
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(packed->data + packed->entries[index].offset);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Creates a string from a string within a packed array
+ * @param packed source array
+ * @param index position of the string within the array
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_strings_packed_string(s_strings_packed_t packed, unsigned long int index)
+{
+	unsigned long int length = 0;
+	const char *str = safe_strings_packed_index(packed, index, &length);
+
+	if(str) {
+		s_string_t retn = _safe_string_allocate(length);
+
+		if(retn) {
+			memcpy(retn->s_string, str, length);
+			_safe_string_stats_copy(length);
+		}
+
+		return(retn); /* use the error code from _safe_string_allocate */
+	} else {
+		return(SAFE_STRING_INVALID); /* use the error code from safe_strings_packed_index */
+	}
+}
+
+/*!
+ * @brief Deletes a packed array along with every string within it
+ * @param packed array to delete
+ */
+void safe_strings_packed_delete(s_strings_packed_t packed)
+{
+	_safe_string_free(packed);
+}
@@ -0,0 +1,95 @@
+/*!
+ * @file utility/packed.h
+ * @brief Header for implementation of packed string arrays
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UTILITY_PACKED_H_
+#define _SAFE_STRING_UTILITY_PACKED_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief (INTERNAL) Allocates an empty packed array able to hold 'count' strings
+ * of 'length' characters in total
+ * @param count amount of strings the array will hold
+ * @param length total amount of characters the strings hold (excluding
+ * terminators)
+ * @return The newly created array, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_strings_packed_t _safe_strings_packed_allocate(unsigned long int, unsigned long int);
+
+/*!
+ * @brief (INTERNAL) Appends a string to a packed array, the array must have been
+ * allocated with enough room for it
+ * @param packed destination array
+ * @param str characters to append
+ * @param length amount of characters to append from 'str'
+ * @param suffix characters to append directly after 'str' (can be
+ * SAFE_STRING_INVALID if 'suffix_length' is 0)
+ * @param suffix_length amount of characters to append from 'suffix'
+ */
+extern void _safe_strings_packed_append(s_strings_packed_t, const char *, unsigned long int, const char *, unsigned long int);
+
+/*!
+ * @brief Gets the amount of strings within a packed array
+ * @param packed source array
+ * @return The amount of strings, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern unsigned long int safe_strings_packed_count(s_strings_packed_t);
+
+/*!
+ * @brief Accesses a string within a packed array without copying it
+ * @param packed source array
+ * @param index position of the string within the array
+ * @param length stores the length of the string (can be SAFE_STRING_INVALID)
+ * @return The terminated characters of the string, which remain valid until the
+ * array is deleted, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern const char *safe_strings_packed_index(s_strings_packed_t, unsigned long int, unsigned long int *);
+
+/*!
+ * @brief Creates a string from a string within a packed array
+ * @param packed source array
+ * @param index position of the string within the array
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_strings_packed_string(s_strings_packed_t, unsigned long int);
+
+/*!
+ * @brief Deletes a packed array along with every string within it
+ * @param packed array to delete
+ */
+extern void safe_strings_packed_delete(s_strings_packed_t);
+
+#endif
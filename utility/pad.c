@@ -36,6 +36,26 @@
 #include "universal.h"
 #include "macro.h"
 
+/*!
+ * @brief (INTERNAL) Fills a range by repeating the characters of a padding string
+ * @param dest destination range (must hold at least 'length' characters)
+ * @param pstr string containing the characters to repeat (must not be empty)
+ * @param length amount of characters to fill
+ */
+static void _safe_string_pad_fill(char *dest, s_string_t pstr, unsigned long int length)
+{
+	unsigned long int i = 0, plength = pstr->s_length - 1;
+
+	if(plength == 1) {
+		_safe_string_range_fill(dest, pstr->s_string[0], length);
+	} else {
+		for(i = 0; i < length; i += plength) {
+			_safe_string_range_copy(dest + i, pstr->s_string, MIN(plength, length - i));
+		}
+	}
+
+	_safe_string_stats_copy(length);
+}
 /*!
  * @brief Pads the right-hand-side of the string with a given amount of
  * characters from a specified set.
@@ -45,10 +65,9 @@
  */
 s_string_t safe_string_lpad_char(s_string_t str, const char *pstr, unsigned long int length)
 {
-	s_string_t temp = safe_string_new(pstr), retn;
-	retn = safe_string_lpad(str, temp, length);
-	safe_string_delete(temp);
-	return(retn);
+	_s_string_t temp;
+
+	return(safe_string_lpad(str, _safe_string_wrap(&temp, pstr), length));
 }
 
 /*!
@@ -60,10 +79,9 @@ s_string_t safe_string_lpad_char(s_string_t str, const char *pstr, unsigned long
  */
 s_string_t safe_string_rpad_char(s_string_t str, const char *pstr, unsigned long int length)
 {
-	s_string_t temp = safe_string_new(pstr), retn;
-	retn = safe_string_rpad(str, temp, length);
-	safe_string_delete(temp);
-	return(retn);
+	_s_string_t temp;
+
+	return(safe_string_rpad(str, _safe_string_wrap(&temp, pstr), length));
 }
 
 /*!
@@ -73,18 +91,21 @@ s_string_t safe_string_rpad_char(s_string_t str, const char *pstr, unsigned long
  * @param pstr string containing set of characters to use as padding
  * @param length length of the new string
  */
-s_string_t safe_string_lpad(s_string_t str, s_string_t pstr, unsigned long int length)
+s_string_t (safe_string_lpad)(s_string_t str, s_string_t pstr, unsigned long int length)
 {
 	if(safe_string_valid(str) && safe_string_valid(pstr)) {
 		if(length > safe_string_length(str) && safe_string_length(pstr)) {
-			unsigned long int i = 0, plength = safe_string_length(pstr);
+			unsigned long int old_length = 0;
 			
-			length -= safe_string_length(str);
-
-			for(i = 0; i < length; i+= plength) {
-				safe_string_concatenate_limit(str, pstr, (length - i < plength) ? length - i : plength);
+			if(!_safe_string_grow(str, length + 1)) {
+				return(SAFE_STRING_INVALID);
 			}
 
+			old_length = str->s_length - 1;
+			_safe_string_pad_fill(str->s_string + old_length, pstr, length - old_length); /* pstr may be str, grown above */
+			str->s_string[length] = '\0';
+			str->s_length = length + 1;
+
 			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 			return(str);
 		} else {
@@ -104,28 +125,23 @@ s_string_t safe_string_lpad(s_string_t str, s_string_t pstr, unsigned long int l
  * @param pstr string containing set of characters to use as padding
  * @param length length of the new string
  */
-s_string_t safe_string_rpad(s_string_t str, s_string_t pstr, unsigned long int length)
+s_string_t (safe_string_rpad)(s_string_t str, s_string_t pstr, unsigned long int length)
 {
 	if(safe_string_valid(str) && safe_string_valid(pstr)) {
 		if(length > safe_string_length(str) && safe_string_length(pstr)) {
-			unsigned long int i = 0, plength = safe_string_length(pstr);
-			s_string_t temp = safe_string_new("");
+			unsigned long int old_length = str->s_length - 1;
+			s_string_t temp = _safe_string_allocate(length);
 
-			if(!safe_string_error()) {
-
-				length -= safe_string_length(str);
-
-				for(i = 0; i < length; i+= plength) {
-					safe_string_concatenate_limit(temp, pstr, (length - i < plength) ? length - i : plength);
-				}
-
-				safe_string_concatenate(temp, str);
+			if(temp) {
+				_safe_string_pad_fill(temp->s_string, pstr, length - old_length);
+				_safe_string_range_copy(temp->s_string + length - old_length, str->s_string, old_length);
+				_safe_string_stats_copy(old_length);
 				safe_string_delete(str);
 
 				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 				return(temp);
 			} else {
-				return(SAFE_STRING_INVALID);
+				return(SAFE_STRING_INVALID); /* use the error code from _safe_string_allocate */
 			}
 		} else {
 			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
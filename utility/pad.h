@@ -71,4 +71,20 @@ extern s_string_t safe_string_lpad(s_string_t, s_string_t, unsigned long int);
  */
 extern s_string_t safe_string_rpad(s_string_t, s_string_t, unsigned long int);
 
+#ifdef SAFE_STRING_GENERIC
+/*!
+ * @brief Pads the left-hand-side of a string with characters given either as a
+ * string or a C string (dispatched to safe_string_lpad_char for C strings,
+ * without allocating)
+ */
+#define safe_string_lpad(str, pstr, length) _safe_string_generic(pstr, safe_string_lpad)(str, pstr, length)
+
+/*!
+ * @brief Pads the right-hand-side of a string with characters given either as a
+ * string or a C string (dispatched to safe_string_rpad_char for C strings,
+ * without allocating)
+ */
+#define safe_string_rpad(str, pstr, length) _safe_string_generic(pstr, safe_string_rpad)(str, pstr, length)
+#endif
+
 #endif
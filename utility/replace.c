@@ -64,25 +64,9 @@ s_string_t safe_string_replace_char(s_string_t str, const char *s1, const char *
 s_string_t safe_string_replace_limit_char(s_string_t str, const char *s1, const char *s2, unsigned long int limit)
 {
 	if(s1 && s2) {
-		s_string_t s1t, s2t;
+		_s_string_t s1t, s2t;
 
-		s1t = safe_string_new(s1);
-
-		if(safe_string_valid(s1t)) {
-			s2t = safe_string_new(s2);
-			if(safe_string_valid(s2t)) {
-				s_string_t retn = safe_string_replace_limit(str, s1t, s2t, limit);
-				safe_string_delete(s1t); safe_string_delete(s2t);
-				return(retn);
-			} else {
-				safe_string_delete(s1t);
-				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-				return(SAFE_STRING_INVALID);
-			}
-		} else {
-			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-			return(SAFE_STRING_INVALID);
-		}
+		return(safe_string_replace_limit(str, _safe_string_wrap(&s1t, s1), _safe_string_wrap(&s2t, s2), limit));
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
 		return(SAFE_STRING_INVALID);
@@ -98,7 +82,7 @@ s_string_t safe_string_replace_limit_char(s_string_t str, const char *s1, const
  * @return Original string with patterns replaced, otherwise SAFE_STRING_INVALID
  * on error.
  */
-s_string_t safe_string_replace(s_string_t str, s_string_t s1, s_string_t s2)
+s_string_t (safe_string_replace)(s_string_t str, s_string_t s1, s_string_t s2)
 {
 	return(safe_string_replace_limit(str, s1, s2, 0));
 }
@@ -114,20 +98,53 @@ s_string_t safe_string_replace(s_string_t str, s_string_t s1, s_string_t s2)
  * @return Original string with patterns replaced, otherwise SAFE_STRING_INVALID
  * on error.
  */
-s_string_t safe_string_replace_limit(s_string_t str, s_string_t s1, s_string_t s2, unsigned long int limit)
+s_string_t (safe_string_replace_limit)(s_string_t str, s_string_t s1, s_string_t s2, unsigned long int limit)
+{
+	return(safe_string_replace_limit_in(SAFE_STRING_INVALID, str, s1, s2, limit));
+}
+
+/*!
+ * @brief Replaces all of the occurrences of a given character pattern with
+ * another in a specified string, allocating the result from an arena.
+ * @param arena arena to allocate the result from (if SAFE_STRING_INVALID then
+ * the heap is used)
+ * @param str source string
+ * @param s1 string to be replaced
+ * @param s2 string to use as replacement
+ * @return Original string with patterns replaced, otherwise SAFE_STRING_INVALID
+ * on error.
+ */
+s_string_t safe_string_replace_in(safe_string_arena_t arena, s_string_t str, s_string_t s1, s_string_t s2)
+{
+	return(safe_string_replace_limit_in(arena, str, s1, s2, 0));
+}
+
+/*!
+ * @brief Replaces an amount of the occurrences of a given character pattern with
+ * another in a specified string, allocating the result from an arena.
+ * @param arena arena to allocate the result from (if SAFE_STRING_INVALID then
+ * the heap is used)
+ * @param str source string
+ * @param s1 string to be replaced
+ * @param s2 string to use as replacement
+ * @param limit the maximum amount of changes to make, if 0 then will replace all
+ * found
+ * @return Original string with patterns replaced, otherwise SAFE_STRING_INVALID
+ * on error.
+ */
+s_string_t safe_string_replace_limit_in(safe_string_arena_t arena, s_string_t str, s_string_t s1, s_string_t s2, unsigned long int limit)
 {
 	unsigned long int count = 0;
 	s_strings_t strs = safe_string_split_limit(str, s1, limit, &count);
 
 	if(!safe_string_error()) {
-		if(count == 1) {
-			return(strs[0]);
-		} else {
-			s_string_t retn = safe_string_join(strs, count, s2);
-			safe_string_array_delete(strs, count);
+		s_string_t retn = safe_string_join_in(arena, strs, count, s2);
+		s_string_error_t error = safe_string_error_val();
+
+		safe_string_array_delete(strs, count);
+		safe_string_set_error(error);
 
-			return(!safe_string_error() ? retn : SAFE_STRING_INVALID);
-		}
+		return(!safe_string_error() ? retn : SAFE_STRING_INVALID);
 	} else {
 		return(SAFE_STRING_INVALID);
 	}
@@ -83,4 +83,48 @@ extern s_string_t safe_string_replace(s_string_t, s_string_t, s_string_t);
  */
 extern s_string_t safe_string_replace_limit(s_string_t, s_string_t, s_string_t, unsigned long int);
 
+/*!
+ * @brief Replaces all of the occurrences of a given character pattern with
+ * another in a specified string, allocating the result from an arena.
+ * @param arena arena to allocate the result from (if SAFE_STRING_INVALID then
+ * the heap is used)
+ * @param str source string
+ * @param s1 string to be replaced
+ * @param s2 string to use as replacement
+ * @return Original string with patterns replaced, otherwise SAFE_STRING_INVALID
+ * on error.
+ */
+extern s_string_t safe_string_replace_in(safe_string_arena_t, s_string_t, s_string_t, s_string_t);
+
+/*!
+ * @brief Replaces an amount of the occurrences of a given character pattern with
+ * another in a specified string, allocating the result from an arena.
+ * @param arena arena to allocate the result from (if SAFE_STRING_INVALID then
+ * the heap is used)
+ * @param str source string
+ * @param s1 string to be replaced
+ * @param s2 string to use as replacement
+ * @param limit the maximum amount of changes to make, if 0 then will replace all
+ * found
+ * @return Original string with patterns replaced, otherwise SAFE_STRING_INVALID
+ * on error.
+ */
+extern s_string_t safe_string_replace_limit_in(safe_string_arena_t, s_string_t, s_string_t, s_string_t, unsigned long int);
+
+#ifdef SAFE_STRING_GENERIC
+/*!
+ * @brief Replaces all occurrences of a pattern, with the pattern and replacement
+ * given either both as strings or both as C strings (dispatched to
+ * safe_string_replace_char for C strings, without allocating)
+ */
+#define safe_string_replace(str, s1, s2) _safe_string_generic(s1, safe_string_replace)(str, s1, s2)
+
+/*!
+ * @brief Replaces an amount of occurrences of a pattern, with the pattern and
+ * replacement given either both as strings or both as C strings (dispatched to
+ * safe_string_replace_limit_char for C strings, without allocating)
+ */
+#define safe_string_replace_limit(str, s1, s2, limit) _safe_string_generic(s1, safe_string_replace_limit)(str, s1, s2, limit)
+#endif
+
 #endif
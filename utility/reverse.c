@@ -34,36 +34,6 @@
 #include "utility.h"
 #include "universal.h"
 
-/*!
- * @brief Swaps two elements in a string. (internal)
- * @param str source string
- * @param start first element to exchange
- * @param end second element to exchange
- */
-inline void _safe_string_index_swap(s_string_t str, unsigned long int start, unsigned long int end)
-{
-	if(safe_string_valid(str)) {
-		if(start <= end && end < safe_string_length(str)) {
-			char c = safe_string_index(str, start);
-
-			safe_string_index_set(str, start, safe_string_index(str, end));
-			safe_string_index_set(str, end, c);
-
-			/* if an error was detected then it will be
-			 * returned from one of the indexing functions
-			 */
-
-			return;
-		} else {
-			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
-			return;
-		}
-	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return;
-	}
-}
-
 /*!
  * @brief Reverses the order of characters of a substring of a string.
  * @param str source string
@@ -75,11 +45,13 @@ s_string_t safe_string_substring_reverse(s_string_t str, unsigned long int start
 {
 	if(safe_string_valid(str)) {
 			if(start <= end && end < safe_string_length(str)) {
-				while(start < end) {
-					_safe_string_index_swap(str, start, end);
-					start++; end--;
+				if(!_safe_string_unshare(str)) {
+					safe_string_set_error(_safe_string_modify_error(str));
+					return(SAFE_STRING_INVALID);
 				}
 
+				_safe_string_range_reverse(str->s_string + start, end - start + 1);
+
 				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 				return(str);
 			} else {
@@ -0,0 +1,617 @@
+/*!
+ * @file utility/rope.c
+ * @brief Implementation of ropes, strings stored as balanced trees of chunks for cheap edits
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memcpy */
+#include "types/types.h"
+#include "universal.h"
+#include "utility.h"
+#include "macro.h"
+
+#define _S_ROPE_LEAF_SIZE 512 /*!< (INTERNAL) Maximum amount of characters stored within a single leaf */
+
+/*!
+ * @brief (INTERNAL) Macro to obtain the height of a possibly empty rope node
+ * @param n source node
+ * @return The height of the node, or 0 if it is empty
+ */
+#define _safe_string_rope_height(n) ((n) ? (n)->height : 0)
+
+typedef struct _s_string_rope_node_t _s_rope_node_t; /*!< (INTERNAL) Shorthand for the node type */
+
+/*!
+ * @brief (INTERNAL) Allocates a leaf holding a copy of a range of characters
+ * @param str characters to copy
+ * @param length amount of characters to copy
+ * @return The newly created leaf, or SAFE_STRING_INVALID if there was an error
+ */
+static _s_rope_node_t *_safe_string_rope_leaf(const char *str, unsigned long int length)
+{
+	_s_rope_node_t *leaf = (_s_rope_node_t *)_safe_string_malloc(sizeof(_s_rope_node_t) + length);
+
+	if(leaf) {
+		leaf->left = leaf->right = SAFE_STRING_INVALID;
+		leaf->length = length;
+		leaf->height = 1;
+		memcpy(leaf->data, str, length);
+	}
+
+	return(leaf);
+}
+
+/*!
+ * @brief (INTERNAL) Releases a node along with every node beneath it
+ * @param node node to release
+ */
+static void _safe_string_rope_free(_s_rope_node_t *node)
+{
+	if(node) {
+		_safe_string_rope_free(node->left);
+		_safe_string_rope_free(node->right);
+		_safe_string_free(node);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Recalculates the length and height of a concatenation node
+ * @param node destination node
+ */
+static void _safe_string_rope_update(_s_rope_node_t *node)
+{
+	node->length = node->left->length + node->right->length;
+	node->height = MAX(node->left->height, node->right->height) + 1;
+}
+
+/*!
+ * @brief (INTERNAL) Rotates a concatenation node to the left
+ * @param node source node (the right child must be a concatenation node)
+ * @return The new root of the subtree
+ */
+static _s_rope_node_t *_safe_string_rope_rotate_left(_s_rope_node_t *node)
+{
+	_s_rope_node_t *root = node->right;
+
+	node->right = root->left;
+	_safe_string_rope_update(node);
+	root->left = node;
+	_safe_string_rope_update(root);
+
+	return(root);
+}
+
+/*!
+ * @brief (INTERNAL) Rotates a concatenation node to the right
+ * @param node source node (the left child must be a concatenation node)
+ * @return The new root of the subtree
+ */
+static _s_rope_node_t *_safe_string_rope_rotate_right(_s_rope_node_t *node)
+{
+	_s_rope_node_t *root = node->left;
+
+	node->left = root->right;
+	_safe_string_rope_update(node);
+	root->right = node;
+	_safe_string_rope_update(root);
+
+	return(root);
+}
+
+/*!
+ * @brief (INTERNAL) Restores the balance of a concatenation node whose children
+ * differ in height by at most two
+ * @param node source node
+ * @return The new root of the subtree
+ */
+static _s_rope_node_t *_safe_string_rope_balance(_s_rope_node_t *node)
+{
+	_safe_string_rope_update(node);
+
+	if(node->left->height > node->right->height + 1) {
+		if(_safe_string_rope_height(node->left->left) < _safe_string_rope_height(node->left->right)) {
+			node->left = _safe_string_rope_rotate_left(node->left);
+		}
+		return(_safe_string_rope_rotate_right(node));
+	} else if(node->right->height > node->left->height + 1) {
+		if(_safe_string_rope_height(node->right->right) < _safe_string_rope_height(node->right->left)) {
+			node->right = _safe_string_rope_rotate_right(node->right);
+		}
+		return(_safe_string_rope_rotate_left(node));
+	}
+
+	return(node);
+}
+
+/*!
+ * @brief (INTERNAL) Concatenates two balanced ropes into a balanced rope in time
+ * proportional to the difference in their heights
+ * @param left characters at the start of the result (can be empty)
+ * @param right characters at the end of the result (can be empty)
+ * @param spare node to use if a concatenation node is required, in which case
+ * the concatenation cannot fail (if SAFE_STRING_INVALID then one is allocated);
+ * it is released if it isn't used
+ * @return The concatenated rope, or SAFE_STRING_INVALID if the result is empty
+ * or there was an error (in which case neither input is modified)
+ */
+static _s_rope_node_t *_safe_string_rope_join(_s_rope_node_t *left, _s_rope_node_t *right, _s_rope_node_t *spare)
+{
+	_s_rope_node_t *node;
+
+	if(!left || !right) {
+		_safe_string_free(spare);
+		return(left ? left : right);
+	}
+
+	if(!left->left && !right->left && left->length + right->length <= _S_ROPE_LEAF_SIZE) { /* merge small leaves */
+		if((node = (_s_rope_node_t *)_safe_string_malloc(sizeof(_s_rope_node_t) + left->length + right->length))) {
+			node->left = node->right = SAFE_STRING_INVALID;
+			node->length = left->length + right->length;
+			node->height = 1;
+			memcpy(node->data, left->data, left->length);
+			memcpy(node->data + left->length, right->data, right->length);
+			_safe_string_free(left);
+			_safe_string_free(right);
+			_safe_string_free(spare);
+			return(node);
+		}
+	}
+
+	if(left->height > right->height + 1) {
+		if(!(node = _safe_string_rope_join(left->right, right, spare))) {
+			return(SAFE_STRING_INVALID);
+		}
+		left->right = node;
+		return(_safe_string_rope_balance(left));
+	} else if(right->height > left->height + 1) {
+		if(!(node = _safe_string_rope_join(left, right->left, spare))) {
+			return(SAFE_STRING_INVALID);
+		}
+		right->left = node;
+		return(_safe_string_rope_balance(right));
+	} else {
+		if(!(node = spare ? spare : (_s_rope_node_t *)_safe_string_malloc(sizeof(_s_rope_node_t)))) {
+			return(SAFE_STRING_INVALID);
+		}
+		node->left = left;
+		node->right = right;
+		_safe_string_rope_update(node);
+		return(node);
+	}
+}
+
+/*!
+ * @brief (INTERNAL) Splits a balanced rope into two balanced ropes
+ * @param node source rope
+ * @param index amount of characters to place within the left-hand rope
+ * @param left stores the characters before the index
+ * @param right stores the characters from the index onwards
+ * @return Non-zero on success, zero otherwise (in which case the rope is left
+ * untouched)
+ * @note Only the leaf containing the index is allocated, before anything is
+ * restructured; the concatenation nodes along the path are reused for joining
+ */
+static int _safe_string_rope_split(_s_rope_node_t *node, unsigned long int index, _s_rope_node_t **left, _s_rope_node_t **right)
+{
+	_s_rope_node_t *middle;
+
+	if(!node || !index) {
+		*left = SAFE_STRING_INVALID;
+		*right = node;
+	} else if(index >= node->length) {
+		*left = node;
+		*right = SAFE_STRING_INVALID;
+	} else if(!node->left) {
+		if(!(*right = _safe_string_rope_leaf(node->data + index, node->length - index))) {
+			return(SAFE_STRING_EMPTY);
+		}
+		node->length = index;
+		*left = node;
+	} else if(index < node->left->length) {
+		if(!_safe_string_rope_split(node->left, index, left, &middle)) {
+			return(SAFE_STRING_EMPTY);
+		}
+		*right = _safe_string_rope_join(middle, node->right, node);
+	} else {
+		if(!_safe_string_rope_split(node->right, index - node->left->length, &middle, right)) {
+			return(SAFE_STRING_EMPTY);
+		}
+		*left = _safe_string_rope_join(node->left, middle, node);
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief (INTERNAL) Builds a balanced rope holding a copy of a range of
+ * characters
+ * @param str characters to copy
+ * @param length amount of characters to copy
+ * @param node stores the rope (SAFE_STRING_INVALID if the range is empty)
+ * @return Non-zero on success, zero otherwise
+ */
+static int _safe_string_rope_build(const char *str, unsigned long int length, _s_rope_node_t **node)
+{
+	if(!length) {
+		*node = SAFE_STRING_INVALID;
+	} else if(length <= _S_ROPE_LEAF_SIZE) {
+		if(!(*node = _safe_string_rope_leaf(str, length))) {
+			return(SAFE_STRING_EMPTY);
+		}
+	} else {
+		unsigned long int half = (((length + _S_ROPE_LEAF_SIZE - 1) / _S_ROPE_LEAF_SIZE) / 2) * _S_ROPE_LEAF_SIZE; /* split on a chunk boundary */
+		_s_rope_node_t *left, *right;
+
+		if(!(*node = (_s_rope_node_t *)_safe_string_malloc(sizeof(_s_rope_node_t)))) {
+			return(SAFE_STRING_EMPTY);
+		}
+
+		if(!_safe_string_rope_build(str, half, &left)) {
+			_safe_string_free(*node);
+			return(SAFE_STRING_EMPTY);
+		}
+
+		if(!_safe_string_rope_build(str + half, length - half, &right)) {
+			_safe_string_rope_free(left);
+			_safe_string_free(*node);
+			return(SAFE_STRING_EMPTY);
+		}
+
+		(*node)->left = left;
+		(*node)->right = right;
+		_safe_string_rope_update(*node);
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief Creates a new rope
+ * @param str string to copy into the rope (if SAFE_STRING_INVALID then the rope
+ * is empty)
+ * @return The newly created rope, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+safe_string_rope_t safe_string_rope_new(s_string_t str)
+{
+	if(!str || safe_string_valid(str)) {
+		safe_string_rope_t rope = (safe_string_rope_t)_safe_string_malloc(sizeof(struct _s_string_rope_t));
+
+		if(rope) {
+			if(_safe_string_rope_build(str ? str->s_string : SAFE_STRING_INVALID, str ? str->s_length - 1 : 0, &rope->root)) {
+				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+				return(rope);
+			}
+			_safe_string_free(rope);
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Deletes a rope
+ * @param rope rope to delete
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_rope_delete(safe_string_rope_t rope)
+{
+	if(rope) {
+		_safe_string_rope_free(rope->root);
+		_safe_string_free(rope);
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+}
+
+/*!
+ * @brief Gets the amount of characters within a rope
+ * @param rope source rope
+ * @return The length of the rope, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+unsigned long int safe_string_rope_length(safe_string_rope_t rope)
+{
+	if(rope) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(rope->root ? rope->root->length : SAFE_STRING_EMPTY);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Gets the character at a given index of a rope in O(log n)
+ * @param rope source rope
+ * @param index index of the character
+ * @return The character, or a NULL value if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+unsigned char safe_string_rope_index(safe_string_rope_t rope, unsigned long int index)
+{
+	if(rope) {
+		struct _s_string_rope_node_t *node = rope->root;
+
+		if(!node || index >= node->length) {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return('\0');
+		}
+
+		while(node->left) {
+			if(index < node->left->length) {
+				node = node->left;
+			} else {
+				index -= node->left->length;
+				node = node->right;
+			}
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(node->data[index]);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return('\0');
+	}
+}
+
+/*!
+ * @brief Appends one rope to another in O(log n), leaving the source empty
+ * @param rope1 destination rope
+ * @param rope2 rope to append (left empty on success, it still has to be deleted)
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_rope_concatenate(safe_string_rope_t rope1, safe_string_rope_t rope2)
+{
+	if(rope1 && rope2 && rope1 != rope2) {
+		struct _s_string_rope_node_t *root = _safe_string_rope_join(rope1->root, rope2->root, SAFE_STRING_INVALID);
+
+		if(!root && (rope1->root || rope2->root)) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return;
+		}
+
+		rope1->root = root;
+		rope2->root = SAFE_STRING_INVALID;
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Appends a copy of a string to a rope in O(log n) (besides copying the
+ * string itself)
+ * @param rope destination rope
+ * @param str string to append
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_rope_concatenate_string(safe_string_rope_t rope, s_string_t str)
+{
+	safe_string_rope_insert(rope, rope ? safe_string_rope_length(rope) : 0, str);
+}
+
+/*!
+ * @brief Inserts a copy of a string into a rope in O(log n) (besides copying the
+ * string itself)
+ * @param rope destination rope
+ * @param index index to insert the string at (can be the length of the rope)
+ * @param str string to insert
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_rope_insert(safe_string_rope_t rope, unsigned long int index, s_string_t str)
+{
+	if(rope && safe_string_valid(str)) {
+		struct _s_string_rope_node_t *piece, *left, *right, *spares[2];
+
+		if(index > (rope->root ? rope->root->length : 0)) {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return;
+		}
+
+		/* allocate everything up front so the rope is never left half edited */
+		spares[0] = (struct _s_string_rope_node_t *)_safe_string_malloc(sizeof(struct _s_string_rope_node_t));
+		spares[1] = (struct _s_string_rope_node_t *)_safe_string_malloc(sizeof(struct _s_string_rope_node_t));
+
+		if(spares[0] && spares[1] && _safe_string_rope_build(str->s_string, str->s_length - 1, &piece)) {
+			if(_safe_string_rope_split(rope->root, index, &left, &right)) {
+				rope->root = _safe_string_rope_join(_safe_string_rope_join(left, piece, spares[0]), right, spares[1]);
+				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+				return;
+			}
+			_safe_string_rope_free(piece);
+		}
+
+		_safe_string_free(spares[0]);
+		_safe_string_free(spares[1]);
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Removes a range of characters from a rope in O(log n)
+ * @param rope destination rope
+ * @param offset index of the first character to remove
+ * @param limit index after the last character to remove (clamped to the length
+ * of the rope)
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_rope_remove(safe_string_rope_t rope, unsigned long int offset, unsigned long int limit)
+{
+	if(rope) {
+		struct _s_string_rope_node_t *left, *middle, *right, *spare;
+		unsigned long int length = rope->root ? rope->root->length : 0;
+
+		if(offset > limit || offset > length) {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return;
+		}
+
+		limit = MIN(limit, length);
+
+		if(!(spare = (struct _s_string_rope_node_t *)_safe_string_malloc(sizeof(struct _s_string_rope_node_t)))) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return;
+		}
+
+		if(!_safe_string_rope_split(rope->root, offset, &left, &right)) {
+			_safe_string_free(spare);
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return;
+		}
+
+		if(!_safe_string_rope_split(right, limit - offset, &middle, &right)) {
+			rope->root = _safe_string_rope_join(left, right, spare); /* put the rope back together */
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return;
+		}
+
+		_safe_string_rope_free(middle);
+		rope->root = _safe_string_rope_join(left, right, spare);
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Splits a rope in two in O(log n)
+ * @param rope source rope, which keeps the characters before the index
+ * @param index index to split at
+ * @return A new rope holding the characters from the index onwards, or
+ * SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+safe_string_rope_t safe_string_rope_split(safe_string_rope_t rope, unsigned long int index)
+{
+	if(rope) {
+		safe_string_rope_t retn;
+
+		if(index > (rope->root ? rope->root->length : 0)) {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return(SAFE_STRING_INVALID);
+		}
+
+		if((retn = (safe_string_rope_t)_safe_string_malloc(sizeof(struct _s_string_rope_t)))) {
+			if(_safe_string_rope_split(rope->root, index, &rope->root, &retn->root)) {
+				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+				return(retn);
+			}
+			_safe_string_free(retn);
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Prepares an iterator over the chunks of a rope
+ * @param rope source rope
+ * @param iterator iterator to prepare
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_string_rope_iterator(safe_string_rope_t rope, s_string_rope_iterator_t *iterator)
+{
+	if(rope && iterator) {
+		iterator->i_depth = 0;
+
+		if(rope->root) {
+			iterator->i_stack[iterator->i_depth++] = rope->root;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Advances an iterator to the next chunk of a rope
+ * @param iterator source iterator
+ * @param chunk stores a view of the chunk's characters
+ * @return Boolean value of true if there was another chunk, else false
+ */
+int safe_string_rope_iterator_next(s_string_rope_iterator_t *iterator, s_string_view_t *chunk)
+{
+	struct _s_string_rope_node_t *node;
+
+	if(!iterator->i_depth) {
+		return(SAFE_STRING_EMPTY);
+	}
+
+	for(node = iterator->i_stack[--iterator->i_depth]; node->left; node = node->left) {
+		iterator->i_stack[iterator->i_depth++] = node->right;
+	}
+
+	*chunk = _safe_string_view_make(node->data, node->length);
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief Flattens a rope into a string
+ * @param rope source rope
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_string_rope_string(safe_string_rope_t rope)
+{
+	if(rope) {
+		s_string_t retn = _safe_string_allocate(rope->root ? rope->root->length : 0);
+
+		if(retn) {
+			s_string_rope_iterator_t iterator;
+			s_string_view_t chunk;
+			char *dest = retn->s_string;
+
+			safe_string_rope_iterator(rope, &iterator);
+
+			while(safe_string_rope_iterator_next(&iterator, &chunk)) {
+				memcpy(dest, chunk.v_string, chunk.v_length);
+				dest += chunk.v_length;
+			}
+
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		}
+
+		return(retn); /* use the error code from _safe_string_allocate */
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
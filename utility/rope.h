@@ -0,0 +1,152 @@
+/*!
+ * @file utility/rope.h
+ * @brief Header for implementation of ropes
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UTILITY_ROPE_H_
+#define _SAFE_STRING_UTILITY_ROPE_H_
+
+#include <stdint.h>
+#include "types/types.h"
+
+/*!
+ * @brief Creates a new rope
+ * @param str string to copy into the rope (if SAFE_STRING_INVALID then the rope
+ * is empty)
+ * @return The newly created rope, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern safe_string_rope_t safe_string_rope_new(s_string_t);
+
+/*!
+ * @brief Deletes a rope
+ * @param rope rope to delete
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_rope_delete(safe_string_rope_t);
+
+/*!
+ * @brief Gets the amount of characters within a rope
+ * @param rope source rope
+ * @return The length of the rope, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern unsigned long int safe_string_rope_length(safe_string_rope_t);
+
+/*!
+ * @brief Gets the character at a given index of a rope in O(log n)
+ * @param rope source rope
+ * @param index index of the character
+ * @return The character, or a NULL value if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern unsigned char safe_string_rope_index(safe_string_rope_t, unsigned long int);
+
+/*!
+ * @brief Appends one rope to another in O(log n), leaving the source empty
+ * @param rope1 destination rope
+ * @param rope2 rope to append (left empty on success, it still has to be deleted)
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_rope_concatenate(safe_string_rope_t, safe_string_rope_t);
+
+/*!
+ * @brief Appends a copy of a string to a rope in O(log n) (besides copying the
+ * string itself)
+ * @param rope destination rope
+ * @param str string to append
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_rope_concatenate_string(safe_string_rope_t, s_string_t);
+
+/*!
+ * @brief Inserts a copy of a string into a rope in O(log n) (besides copying the
+ * string itself)
+ * @param rope destination rope
+ * @param index index to insert the string at (can be the length of the rope)
+ * @param str string to insert
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_rope_insert(safe_string_rope_t, unsigned long int, s_string_t);
+
+/*!
+ * @brief Removes a range of characters from a rope in O(log n)
+ * @param rope destination rope
+ * @param offset index of the first character to remove
+ * @param limit index after the last character to remove (clamped to the length
+ * of the rope)
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_rope_remove(safe_string_rope_t, unsigned long int, unsigned long int);
+
+/*!
+ * @brief Splits a rope in two in O(log n)
+ * @param rope source rope, which keeps the characters before the index
+ * @param index index to split at
+ * @return A new rope holding the characters from the index onwards, or
+ * SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern safe_string_rope_t safe_string_rope_split(safe_string_rope_t, unsigned long int);
+
+/*!
+ * @brief Prepares an iterator over the chunks of a rope
+ * @param rope source rope
+ * @param iterator iterator to prepare
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_string_rope_iterator(safe_string_rope_t, s_string_rope_iterator_t *);
+
+/*!
+ * @brief Advances an iterator to the next chunk of a rope
+ * @param iterator source iterator
+ * @param chunk stores a view of the chunk's characters
+ * @return Boolean value of true if there was another chunk, else false
+ */
+extern int safe_string_rope_iterator_next(s_string_rope_iterator_t *, s_string_view_t *);
+
+/*!
+ * @brief Flattens a rope into a string
+ * @param rope source rope
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_string_rope_string(safe_string_rope_t);
+
+/*!
+ * @brief Generates the CRC32 checksum of a given rope, chunk by chunk without
+ * flattening it
+ * @param rope the source rope
+ * @return The CRC32 checksum calculated from the given rope
+ * @note Sets the error variable indicating success or failure
+ */
+extern uint32_t safe_string_rope_crc32(safe_string_rope_t);
+
+#endif
@@ -38,86 +38,118 @@
 #include "macro.h"
 
 /*!
- * @brief Splits a string based upon a delimeter into at most 'elements' strings
+ * @brief (INTERNAL) Locates the offsets of (at most 'elements') delimeters within a range, shared by every split so they
+ * all agree on where the pieces are
+ * @param str source range to search
+ * @param length amount of characters within the source range
+ * @param delim delimeter to search for
+ * @param delim_length amount of characters within the delimeter (must not be 0)
+ * @param elements the amount of delimeters (at most) to locate (can be 0, if this is the case we treat elements as infinite)
+ * @param found stores the amount of delimeters located
+ * @return Array of offsets (to be released with _safe_string_free), or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ * @note Delimeters are matched from the start without overlapping, a delimeter at either end leaves an empty piece there.
+ */
+static unsigned long int *_safe_string_split_offsets(const char *str, unsigned long int length, const char *delim, unsigned long int delim_length, unsigned long int elements, unsigned long int *found)
+{
+	unsigned long int i = 0, limit = length / delim_length; /* delimeters don't overlap, so there can't be more */
+	unsigned long int *offsets = (unsigned long int *)_safe_string_malloc(sizeof(unsigned long int) * MAX(limit, 1));
+
+	*found = 0;
+
+	if(offsets) {
+		while((*found < limit) && ((*found < elements) || !elements)) { /* if elements = 0, then we don't care how many we find */
+			unsigned long int offset = _safe_string_range_find(str + i, length - i, delim, delim_length);
+
+			if(offset == length - i) {
+				break;
+			}
+
+			offsets[(*found)++] = i + offset;
+			i += offset + delim_length;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(offsets);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Splits a string based upon a delimeter into at most 'elements' strings, allocating the result from an arena
+ * @param arena arena to allocate the array and it's strings from (if SAFE_STRING_INVALID then the heap is used)
  * @param str source string to split
  * @param delim delimeter to split on
  * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
  * @param count the amount of strings to be returned
  * @return Strings containing the split substrings of the source string, some elements may be NULL where the delimeter has
  * repeated, or where there was no string before or after. (Should be checked by caller).
- * @note Error value is set to indicate success or failure.
+ * @note Error value is set to indicate success or failure, an empty delimeter
+ * is rejected with SAFE_STRING_ERROR_INVALID_ARG.
  */
-s_strings_t safe_string_split_limit(s_string_t str, s_string_t delim, unsigned long int elements, unsigned long int *count)
+s_strings_t safe_string_split_limit_in(safe_string_arena_t arena, s_string_t str, s_string_t delim, unsigned long int elements, unsigned long int *count)
 {
 	if(safe_string_valid(str) && safe_string_valid(delim) && count) {
-		if(safe_string_length(delim) < safe_string_length(str)) {
-			unsigned long int i = 0, j = 0, limit = safe_string_length(str) / safe_string_length(delim), found = 0;
-			unsigned long int *offsets = (unsigned long int *)malloc(sizeof(unsigned long int) * limit);
+		if(!safe_string_length(delim)) {
+			*count = SAFE_STRING_EMPTY;
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		} else if(safe_string_length(delim) <= safe_string_length(str)) {
+			unsigned long int i = 0, j = 0, found = 0;
+			unsigned long int *offsets = _safe_string_split_offsets(str->s_string, safe_string_length(str), delim->s_string, safe_string_length(delim), elements, &found);
 
 			if(offsets) {
-				while((i < limit) && ((found < elements) || !elements)) { /* if elements = 0, then we don't care how many we find */
-					offsets[found] = safe_string_string_locate_offset(str, delim, i);
-
-					if(safe_string_error()) {
-						if(safe_string_error_val() != SAFE_STRING_ERROR_INVALID_RETURN) {
-							free(offsets);
-							return(SAFE_STRING_INVALID);
-						} else {
-							break;
-						}
-					} else {
-						i = offsets[found++] + safe_string_length(delim) ;
-					}
-				}
-
-				s_strings_t retn = (s_strings_t)calloc(found + 2, sizeof(s_string_t)); /* maximum size */
+				s_strings_t retn = _safe_string_array_allocate_in(arena, found + 2); /* maximum size */
 
 				if(retn) {
 
 					for(i = 0; i < found; j = offsets[i] + safe_string_length(delim), i++) {
-						retn[i] = safe_string_substring(str, j, offsets[i]);
+						retn[i] = _safe_string_allocate_copy_in(arena, str->s_string + j, offsets[i] - j);
 					}
 
-					retn[i++] = (j >= safe_string_length(str)) ? safe_string_new("") :  safe_string_substring(str, j, safe_string_length(str)); /* always needed */
-					if(realloc(retn, i * sizeof(s_string_t))) {
-						free(offsets);
+					retn[i++] = _safe_string_allocate_copy_in(arena, str->s_string + j, (j >= safe_string_length(str)) ? 0 : safe_string_length(str) - j); /* always needed */
+					s_strings_t shrunk = arena ? retn : (s_strings_t)_safe_string_realloc(retn, i * sizeof(s_string_t));
+
+					if(shrunk) {
+						_safe_string_free(offsets);
 						*count = i;
 						safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-						return(retn);
+						return(shrunk);
 					} else {
 						*count = SAFE_STRING_EMPTY;
-						free(offsets);
-						safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+						_safe_string_free(offsets);
+						safe_string_array_delete(retn, i);
+						safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 						return(SAFE_STRING_INVALID);
 					}
 				} else {
-					free(offsets);
-					safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-					return(SAFE_STRING_INVALID);
+					_safe_string_free(offsets);
+					return(SAFE_STRING_INVALID); /* use the error code from _safe_string_array_allocate_in */
 				}
 			} else {
-				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-				return(SAFE_STRING_INVALID);
+				return(SAFE_STRING_INVALID); /* use the error code from _safe_string_split_offsets */
 			}
 		} else {
-			s_strings_t retn = (s_strings_t)calloc(1, sizeof(s_string_t));
+			s_strings_t retn = _safe_string_array_allocate_in(arena, 1);
 			if(retn) {
-				unsigned long int chars;
-				retn[0] = safe_string_new(safe_string_access_characters(str, &chars));
+				retn[0] = safe_string_duplicate_in(arena, str);
 				if(retn[0]) {
 					*count = 1;
 					safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
 					return(retn); /* this is the case where we don't need to split */
 				} else {
-					free(retn);
+					if(!arena) {
+						_safe_string_free(retn);
+					}
 					*count = SAFE_STRING_EMPTY;
 					safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 					return(SAFE_STRING_INVALID);
 				}
 			} else 	{
 				*count = SAFE_STRING_EMPTY;
-				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-				return(SAFE_STRING_INVALID);
+				return(SAFE_STRING_INVALID); /* use the error code from _safe_string_array_allocate_in */
 			}
 		}
 	} else {
@@ -126,6 +158,21 @@ s_strings_t safe_string_split_limit(s_string_t str, s_string_t delim, unsigned l
 	}
 }
 
+/*!
+ * @brief Splits a string based upon a delimeter into at most 'elements' strings
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
+ * @param count the amount of strings to be returned
+ * @return Strings containing the split substrings of the source string, some elements may be NULL where the delimeter has
+ * repeated, or where there was no string before or after. (Should be checked by caller).
+ * @note Error value is set to indicate success or failure.
+ */
+s_strings_t (safe_string_split_limit)(s_string_t str, s_string_t delim, unsigned long int elements, unsigned long int *count)
+{
+	return(safe_string_split_limit_in(SAFE_STRING_INVALID, str, delim, elements, count));
+}
+
 /*!
  * @brief Splits the string using a C string delimeter
  * @param str source string
@@ -138,12 +185,9 @@ s_strings_t safe_string_split_limit(s_string_t str, s_string_t delim, unsigned l
  */
 s_strings_t safe_string_split_limit_char(s_string_t str, const char *delim, unsigned long int elements, unsigned long int *count)
 {
-	s_string_t temp = safe_string_new(delim);
-	s_strings_t retn = safe_string_split_limit(str, temp, elements, count);
-	s_string_error_t error = safe_string_error_val();
-	safe_string_delete(temp);
-	safe_string_set_error(error);
-	return(retn);
+	_s_string_t temp;
+
+	return(safe_string_split_limit(str, _safe_string_wrap(&temp, delim), elements, count));
 }
 
 /*!
@@ -157,12 +201,9 @@ s_strings_t safe_string_split_limit_char(s_string_t str, const char *delim, unsi
  */
 s_strings_t safe_string_split_char(s_string_t str, const char *delim, unsigned long int *count)
 {
-	s_string_t temp = safe_string_new(delim);
-	s_strings_t retn = safe_string_split_limit(str, temp, 0, count);
-	s_string_error_t error = safe_string_error_val();
-	safe_string_delete(temp);
-	safe_string_set_error(error);
-	return(retn);
+	_s_string_t temp;
+
+	return(safe_string_split_limit(str, _safe_string_wrap(&temp, delim), 0, count));
 }
 
 /*!
@@ -174,7 +215,189 @@ s_strings_t safe_string_split_char(s_string_t str, const char *delim, unsigned l
  * repeated, or where there was no string before or after. (Should be checked by caller).
  * @note Error value is set to indicate success or failure.
  */
-s_strings_t safe_string_split(s_string_t str, s_string_t delim, unsigned long int *count)
+s_strings_t (safe_string_split)(s_string_t str, s_string_t delim, unsigned long int *count)
 {
 	return(safe_string_split_limit(str, delim, 0, count));
 }
+
+/*!
+ * @brief Splits the string using a delimeter with no limit on amount of splits, allocating the result from an arena
+ * @param arena arena to allocate the array and it's strings from (if SAFE_STRING_INVALID then the heap is used)
+ * @param str source string
+ * @param delim C string delimeter to split on
+ * @param count stores the amount of strings created from splitting
+ * @return Strings containing the split substrings of the source string, some elements may be NULL where the delimeter has
+ * repeated, or where there was no string before or after. (Should be checked by caller).
+ * @note Error value is set to indicate success or failure.
+ */
+s_strings_t safe_string_split_in(safe_string_arena_t arena, s_string_t str, s_string_t delim, unsigned long int *count)
+{
+	return(safe_string_split_limit_in(arena, str, delim, 0, count));
+}
+
+/*!
+ * @brief Splits a string based upon a delimeter into at most 'elements' strings, packed into a single allocation
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
+ * @return Packed array containing the split substrings of the source string (empty where the delimeter has repeated, or
+ * where there was no string before or after), or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure, an empty delimeter
+ * is rejected with SAFE_STRING_ERROR_INVALID_ARG.
+ */
+s_strings_packed_t safe_string_split_limit_packed(s_string_t str, s_string_t delim, unsigned long int elements)
+{
+	if(safe_string_valid(str) && safe_string_valid(delim)) {
+		s_strings_packed_t retn;
+
+		if(!safe_string_length(delim)) {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		} else if(safe_string_length(delim) <= safe_string_length(str)) {
+			unsigned long int i = 0, j = 0, found = 0;
+			unsigned long int *offsets = _safe_string_split_offsets(str->s_string, safe_string_length(str), delim->s_string, safe_string_length(delim), elements, &found);
+
+			if(offsets) {
+				retn = _safe_strings_packed_allocate(found + 1, safe_string_length(str) - found * safe_string_length(delim));
+
+				if(retn) {
+					for(i = 0; i < found; j = offsets[i] + safe_string_length(delim), i++) {
+						_safe_strings_packed_append(retn, str->s_string + j, offsets[i] - j, SAFE_STRING_INVALID, 0);
+					}
+
+					_safe_strings_packed_append(retn, str->s_string + j, safe_string_length(str) - j, SAFE_STRING_INVALID, 0); /* always needed */
+				}
+
+				_safe_string_free(offsets);
+				return(retn); /* use the error code from _safe_strings_packed_allocate */
+			} else {
+				return(SAFE_STRING_INVALID); /* use the error code from _safe_string_split_offsets */
+			}
+		} else {
+			retn = _safe_strings_packed_allocate(1, safe_string_length(str));
+
+			if(retn) {
+				_safe_strings_packed_append(retn, str->s_string, safe_string_length(str), SAFE_STRING_INVALID, 0); /* this is the case where we don't need to split */
+			}
+
+			return(retn); /* use the error code from _safe_strings_packed_allocate */
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Splits a string based upon a delimeter with no limit on amount of splits, packed into a single allocation
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @return Packed array containing the split substrings of the source string, or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+s_strings_packed_t safe_string_split_packed(s_string_t str, s_string_t delim)
+{
+	return(safe_string_split_limit_packed(str, delim, 0));
+}
+
+/*!
+ * @brief Splits a view based upon a delimeter into at most 'elements' views, without copying
+ * @param str source view to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
+ * @param count the amount of views to be returned
+ * @return Array of views referring to the split ranges of the source (empty where the delimeter has repeated, or where
+ * there was no string before or after), to be released with safe_string_free, or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+s_string_view_t *safe_string_split_limit_view(s_string_view_t str, s_string_view_t delim, unsigned long int elements, unsigned long int *count)
+{
+	if(safe_string_view_valid(str) && safe_string_view_valid(delim) && count) {
+		if(delim.v_length) {
+			unsigned long int i = 0, j = 0, found = 0;
+			unsigned long int *offsets = _safe_string_split_offsets(str.v_string, str.v_length, delim.v_string, delim.v_length, elements, &found);
+			s_string_view_t *retn;
+
+			if(!offsets) {
+				*count = SAFE_STRING_EMPTY;
+				return(SAFE_STRING_INVALID); /* use the error code from _safe_string_split_offsets */
+			}
+
+			if(!(retn = (s_string_view_t *)_safe_string_malloc((found + 1) * sizeof(s_string_view_t)))) {
+				*count = SAFE_STRING_EMPTY;
+				_safe_string_free(offsets);
+				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+				return(SAFE_STRING_INVALID);
+			}
+
+			_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, (found + 1) * sizeof(s_string_view_t));
+
+			for(i = 0; i < found; j = offsets[i] + delim.v_length, i++) {
+				retn[i] = _safe_string_view_make(str.v_string + j, offsets[i] - j);
+			}
+
+			retn[i++] = _safe_string_view_make(str.v_string + j, str.v_length - j); /* always needed */
+
+			_safe_string_free(offsets);
+			*count = i;
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(retn);
+		} else {
+			*count = SAFE_STRING_EMPTY;
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Splits a view based upon a delimeter with no limit on amount of splits, without copying
+ * @param str source view to split
+ * @param delim delimeter to split on
+ * @param count the amount of views to be returned
+ * @return Array of views referring to the split ranges of the source, to be released with safe_string_free, or
+ * SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+s_string_view_t *safe_string_split_view(s_string_view_t str, s_string_view_t delim, unsigned long int *count)
+{
+	return(safe_string_split_limit_view(str, delim, 0, count));
+}
+
+/*!
+ * @brief Splits a string based upon a delimeter into a vector of at most
+ * 'elements' strings
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (0 for no limit)
+ * @return Vector holding the split substrings of the source string (some may be
+ * invalid, see safe_strings_vec_valid), or SAFE_STRING_INVALID if there was an
+ * error
+ * @note Error value is set to indicate success or failure, an empty delimeter
+ * is rejected with SAFE_STRING_ERROR_INVALID_ARG.
+ */
+safe_strings_vec_t safe_string_split_limit_vec(s_string_t str, s_string_t delim, unsigned long int elements)
+{
+	unsigned long int count = 0;
+	s_strings_t strs = safe_string_split_limit_in(SAFE_STRING_INVALID, str, delim, elements, &count);
+
+	return(_safe_strings_vec_adopt(strs, count));
+}
+
+/*!
+ * @brief Splits a string based upon a delimeter into a vector, with no limit on
+ * the amount of splits
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @return Vector holding the split substrings of the source string (some may be
+ * invalid, see safe_strings_vec_valid), or SAFE_STRING_INVALID if there was an
+ * error
+ * @note Error value is set to indicate success or failure.
+ */
+safe_strings_vec_t safe_string_split_vec(s_string_t str, s_string_t delim)
+{
+	return(safe_string_split_limit_vec(str, delim, 0));
+}
@@ -31,6 +31,9 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifndef _SAFE_STRING_UTILITY_SPLIT_H_
+#define _SAFE_STRING_UTILITY_SPLIT_H_
+
 #include "types/types.h"
 
 /*!
@@ -78,3 +81,113 @@ extern s_strings_t safe_string_split_char(s_string_t, const char *, unsigned lon
  * @note Error value is set to indicate success or failure.
  */
 extern s_strings_t safe_string_split_limit_char(s_string_t, const char *, unsigned long int, unsigned long int *);
+
+/*!
+ * @brief Splits a string based upon a delimeter into at most 'elements' strings, allocating the result from an arena
+ * @param arena arena to allocate the array and it's strings from (if SAFE_STRING_INVALID then the heap is used)
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
+ * @param count the amount of strings to be returned
+ * @return Strings containing the split substrings of the source string, some elements may be NULL where the delimeter has
+ * repeated, or where there was no string before or after. (Should be checked by caller).
+ * @note Error value is set to indicate success or failure.
+ */
+extern s_strings_t safe_string_split_limit_in(safe_string_arena_t, s_string_t, s_string_t, unsigned long int, unsigned long int *);
+
+/*!
+ * @brief Splits the string using a delimeter with no limit on amount of splits, allocating the result from an arena
+ * @param arena arena to allocate the array and it's strings from (if SAFE_STRING_INVALID then the heap is used)
+ * @param str source string
+ * @param delim C string delimeter to split on
+ * @param count stores the amount of strings created from splitting
+ * @return Strings containing the split substrings of the source string, some elements may be NULL where the delimeter has
+ * repeated, or where there was no string before or after. (Should be checked by caller).
+ * @note Error value is set to indicate success or failure.
+ */
+extern s_strings_t safe_string_split_in(safe_string_arena_t, s_string_t, s_string_t, unsigned long int *);
+
+/*!
+ * @brief Splits a string based upon a delimeter into at most 'elements' strings, packed into a single allocation
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
+ * @return Packed array containing the split substrings of the source string (empty where the delimeter has repeated, or
+ * where there was no string before or after), or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+extern s_strings_packed_t safe_string_split_limit_packed(s_string_t, s_string_t, unsigned long int);
+
+/*!
+ * @brief Splits a string based upon a delimeter with no limit on amount of splits, packed into a single allocation
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @return Packed array containing the split substrings of the source string, or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+extern s_strings_packed_t safe_string_split_packed(s_string_t, s_string_t);
+
+/*!
+ * @brief Splits a view based upon a delimeter into at most 'elements' views, without copying
+ * @param str source view to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (can be 0, if this is the case we treat elements as infinite)
+ * @param count the amount of views to be returned
+ * @return Array of views referring to the split ranges of the source (empty where the delimeter has repeated, or where
+ * there was no string before or after), to be released with safe_string_free, or SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+extern s_string_view_t *safe_string_split_limit_view(s_string_view_t, s_string_view_t, unsigned long int, unsigned long int *);
+
+/*!
+ * @brief Splits a view based upon a delimeter with no limit on amount of splits, without copying
+ * @param str source view to split
+ * @param delim delimeter to split on
+ * @param count the amount of views to be returned
+ * @return Array of views referring to the split ranges of the source, to be released with safe_string_free, or
+ * SAFE_STRING_INVALID if there was an error
+ * @note Error value is set to indicate success or failure.
+ */
+extern s_string_view_t *safe_string_split_view(s_string_view_t, s_string_view_t, unsigned long int *);
+
+/*!
+ * @brief Splits a string based upon a delimeter into a vector of at most
+ * 'elements' strings
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @param elements the amount of times (at most) to split (0 for no limit)
+ * @return Vector holding the split substrings of the source string (some may be
+ * invalid, see safe_strings_vec_valid), or SAFE_STRING_INVALID if there was an
+ * error
+ * @note Error value is set to indicate success or failure.
+ */
+extern safe_strings_vec_t safe_string_split_limit_vec(s_string_t, s_string_t, unsigned long int);
+
+/*!
+ * @brief Splits a string based upon a delimeter into a vector, with no limit on
+ * the amount of splits
+ * @param str source string to split
+ * @param delim delimeter to split on
+ * @return Vector holding the split substrings of the source string (some may be
+ * invalid, see safe_strings_vec_valid), or SAFE_STRING_INVALID if there was an
+ * error
+ * @note Error value is set to indicate success or failure.
+ */
+extern safe_strings_vec_t safe_string_split_vec(s_string_t, s_string_t);
+
+#ifdef SAFE_STRING_GENERIC
+/*!
+ * @brief Splits a string upon a delimeter given either as a string or a C string
+ * (dispatched to safe_string_split_char for C strings, without allocating)
+ */
+#define safe_string_split(str, delim, count) _safe_string_generic(delim, safe_string_split)(str, delim, count)
+
+/*!
+ * @brief Splits a string at most 'elements' times upon a delimeter given either
+ * as a string or a C string (dispatched to safe_string_split_limit_char for C
+ * strings, without allocating)
+ */
+#define safe_string_split_limit(str, delim, elements, count) _safe_string_generic(delim, safe_string_split_limit)(str, delim, elements, count)
+#endif
+
+#endif
@@ -54,12 +54,11 @@ unsigned long int safe_string_string_locate_offset_limit(s_string_t haystack, s_
 			unsigned long int search_limit = limit - safe_string_length(needle);
 
 			if(search_limit < limit) { /* only fails if length of needle was greater than limit or the string is nothing */
-				while(offset < limit) {
-					if(!safe_string_substring_compare(haystack, needle, offset)) {
-						safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-						return(offset);
-					}
-					offset++;
+				unsigned long int found = _safe_string_range_find(haystack->s_string + offset, limit - offset, needle->s_string, needle->s_length - 1);
+
+				if(found < limit - offset) {
+					safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+					return(offset + found);
 				}
 				
 				safe_string_set_error(SAFE_STRING_ERROR_INVALID_RETURN);
@@ -126,3 +125,113 @@ unsigned long int safe_string_string_locate(s_string_t haystack, s_string_t need
 {
 	return(safe_string_string_locate_offset(haystack, needle, 0));
 }
+
+/*!
+ * @brief Finds the offset of a view within another view using a lower bound.
+ * @param haystack source view
+ * @param needle view to find
+ * @param offset starting offset to search from
+ * @return The index of the first letter of the first occurance of the needle
+ * within the haystack. If the needle is not found then the error value is set
+ * to SAFE_STRING_INVALID_RETURN and 0 is returned.
+ * @note The error value is set indicating success or failure.
+ */
+unsigned long int safe_string_string_locate_offset_view(s_string_view_t haystack, s_string_view_t needle, unsigned long int offset)
+{
+	if(safe_string_view_valid(haystack) && safe_string_view_valid(needle)) {
+		if(offset <= haystack.v_length && needle.v_length) {
+			unsigned long int found = _safe_string_range_find(haystack.v_string + offset, haystack.v_length - offset, needle.v_string, needle.v_length);
+
+			if(found < haystack.v_length - offset) {
+				safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+				return(offset + found);
+			}
+
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_RETURN);
+			return(SAFE_STRING_EMPTY);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_EMPTY);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Finds the offset of a view within another view.
+ * @param haystack source view
+ * @param needle view to find
+ * @return The index of the first letter of the first occurance of the needle
+ * within the haystack. If the needle is not found then the error value is set
+ * to SAFE_STRING_INVALID_RETURN and 0 is returned.
+ * @note The error value is set indicating success or failure.
+ */
+unsigned long int safe_string_string_locate_view(s_string_view_t haystack, s_string_view_t needle)
+{
+	return(safe_string_string_locate_offset_view(haystack, needle, 0));
+}
+
+/*!
+ * @brief Finds the offset of a string within a rope, chunk by chunk without
+ * flattening the rope (matches may span chunks)
+ * @param rope source rope
+ * @param needle string to find
+ * @return The index of the first letter of the first occurance of the string
+ * within the rope. If the string is not found then the error value is set to
+ * SAFE_STRING_INVALID_RETURN and 0 is returned.
+ * @note The error value is set indicating success or failure.
+ */
+unsigned long int safe_string_rope_locate(safe_string_rope_t rope, s_string_t needle)
+{
+	if(rope && safe_string_valid(needle)) {
+		unsigned long int i = 0, j = 0, offset = 0, length = safe_string_length(needle);
+		unsigned long int *failure;
+		s_string_rope_iterator_t iterator;
+		s_string_view_t chunk;
+
+		if(!length) {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(SAFE_STRING_EMPTY);
+		}
+
+		if(!(failure = (unsigned long int *)_safe_string_malloc(length * sizeof(unsigned long int)))) {
+			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+			return(SAFE_STRING_EMPTY);
+		}
+
+		/* Knuth-Morris-Pratt, so each character of the rope is visited once */
+		for(failure[0] = 0, i = 1, j = 0; i < length; i++) {
+			while(j && needle->s_string[i] != needle->s_string[j]) {
+				j = failure[j - 1];
+			}
+			if(needle->s_string[i] == needle->s_string[j]) {
+				j++;
+			}
+			failure[i] = j;
+		}
+
+		safe_string_rope_iterator(rope, &iterator);
+
+		for(j = 0; safe_string_rope_iterator_next(&iterator, &chunk); offset += chunk.v_length) {
+			for(i = 0; i < chunk.v_length; i++) {
+				while(j && chunk.v_string[i] != needle->s_string[j]) {
+					j = failure[j - 1];
+				}
+				if(chunk.v_string[i] == needle->s_string[j] && ++j == length) {
+					_safe_string_free(failure);
+					safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+					return(offset + i + 1 - length);
+				}
+			}
+		}
+
+		_safe_string_free(failure);
+		safe_string_set_error(SAFE_STRING_ERROR_INVALID_RETURN);
+		return(SAFE_STRING_EMPTY);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
@@ -84,4 +84,39 @@ extern unsigned long int safe_string_string_locate_offset(s_string_t, s_string_t
  */
 extern unsigned long int safe_string_string_locate(s_string_t, s_string_t);
 
+/*!
+ * @brief Finds the offset of a view within another view using a lower bound.
+ * @param haystack source view
+ * @param needle view to find
+ * @param offset starting offset to search from
+ * @return The index of the first letter of the first occurance of the needle
+ * within the haystack. If the needle is not found then the error value is set
+ * to SAFE_STRING_INVALID_RETURN and 0 is returned.
+ * @note The error value is set indicating success or failure.
+ */
+extern unsigned long int safe_string_string_locate_offset_view(s_string_view_t, s_string_view_t, unsigned long int);
+
+/*!
+ * @brief Finds the offset of a view within another view.
+ * @param haystack source view
+ * @param needle view to find
+ * @return The index of the first letter of the first occurance of the needle
+ * within the haystack. If the needle is not found then the error value is set
+ * to SAFE_STRING_INVALID_RETURN and 0 is returned.
+ * @note The error value is set indicating success or failure.
+ */
+extern unsigned long int safe_string_string_locate_view(s_string_view_t, s_string_view_t);
+
+/*!
+ * @brief Finds the offset of a string within a rope, chunk by chunk without
+ * flattening the rope (matches may span chunks)
+ * @param rope source rope
+ * @param needle string to find
+ * @return The index of the first letter of the first occurance of the string
+ * within the rope. If the string is not found then the error value is set to
+ * SAFE_STRING_INVALID_RETURN and 0 is returned.
+ * @note The error value is set indicating success or failure.
+ */
+extern unsigned long int safe_string_rope_locate(safe_string_rope_t, s_string_t);
+
 #endif
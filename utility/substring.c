@@ -30,14 +30,16 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdlib.h>
 #include "types/types.h"
 #include "universal.h"
 #include "utility.h"
 #include "macro.h"
 
 /*!
- * @brief Extracts a string from within another string.
+ * @brief Extracts a string from within another string, allocating the result
+ * from an arena.
+ * @param arena arena to allocate the result from (if SAFE_STRING_INVALID then
+ * the heap is used)
  * @param str source string
  * @param offset starting index for extraction
  * @param limit ending index for extraction
@@ -45,34 +47,13 @@
  * and 'limit'.
  * @note Sets the error value indicating success or failure.
  */
-s_string_t safe_string_substring(s_string_t str, unsigned long int offset, unsigned long int limit)
+s_string_t safe_string_substring_in(safe_string_arena_t arena, s_string_t str, unsigned long int offset, unsigned long int limit)
 {
 	if(safe_string_valid(str)) {
 		if(offset < safe_string_length(str) && offset <= limit) {
 			limit = MIN(safe_string_length(str), limit);
 
-			if(limit - offset) {
-				char *string = (char *)calloc((limit - offset) + 1, sizeof(char));
-
-				if(string) {
-					unsigned int i = 0;
-					s_string_t retn;
-
-					while(offset < limit) {
-						string[i++] = safe_string_index(str, offset++);
-					}
-
-					retn = safe_string_new(string);
-					free(string);
-
-					return(retn); /* use the error code from safe_string_new */
-				} else {
-					safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-					return(SAFE_STRING_INVALID);
-				}
-			} else {
-				return(safe_string_new(SAFE_STRING_INVALID));
-			}
+			return(_safe_string_allocate_copy_in(arena, str->s_string + offset, limit - offset)); /* use the error code from _safe_string_allocate_copy_in */
 		} else {
 			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
 			return(SAFE_STRING_INVALID);
@@ -83,6 +64,20 @@ s_string_t safe_string_substring(s_string_t str, unsigned long int offset, unsig
 	}
 }
 
+/*!
+ * @brief Extracts a string from within another string.
+ * @param str source string
+ * @param offset starting index for extraction
+ * @param limit ending index for extraction
+ * @return A safe string containing the substring defined by the bounaries 'offset'
+ * and 'limit'.
+ * @note Sets the error value indicating success or failure.
+ */
+s_string_t safe_string_substring(s_string_t str, unsigned long int offset, unsigned long int limit)
+{
+	return(safe_string_substring_in(SAFE_STRING_INVALID, str, offset, limit));
+}
+
 /*!
  * @brief Extracts a string from within another string. Using only a starting position,
  * extraction is performed using the length of the string as an upper bound.
@@ -101,3 +96,31 @@ s_string_t safe_string_substring_auto(s_string_t str, unsigned long int offset)
 		return(SAFE_STRING_INVALID);
 	}
 }
+
+/*!
+ * @brief Refers to a string within another string without copying it.
+ * @param str source string
+ * @param offset starting index of the view
+ * @param limit ending index of the view
+ * @return A view of the substring defined by the boundaries 'offset' and
+ * 'limit', or an invalid view if there was an error.
+ * @note Sets the error value indicating success or failure.
+ */
+s_string_view_t safe_string_substring_view(s_string_t str, unsigned long int offset, unsigned long int limit)
+{
+	return(safe_string_view_slice(safe_string_view(str), offset, limit));
+}
+
+/*!
+ * @brief Refers to a string within another string without copying it. Using only
+ * a starting position, the length of the string is used as an upper bound.
+ * @param str source string
+ * @param offset starting index of the view
+ * @return A view of the substring defined by the boundary 'offset' and the length
+ * of the source string, or an invalid view if there was an error.
+ * @note Sets the error value indicating success or failure.
+ */
+s_string_view_t safe_string_substring_auto_view(s_string_t str, unsigned long int offset)
+{
+	return(safe_string_view_slice(safe_string_view(str), offset, str ? safe_string_length(str) : 0));
+}
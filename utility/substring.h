@@ -46,6 +46,20 @@
  */
 extern s_string_t safe_string_substring(s_string_t str, unsigned long int, unsigned long int);
 
+/*!
+ * @brief Extracts a string from within another string, allocating the result
+ * from an arena.
+ * @param arena arena to allocate the result from (if SAFE_STRING_INVALID then
+ * the heap is used)
+ * @param str source string
+ * @param offset starting index for extraction
+ * @param limit ending index for extraction
+ * @return A safe string containing the substring defined by the bounaries 'offset'
+ * and 'limit'.
+ * @note Sets the error value indicating success or failure.
+ */
+extern s_string_t safe_string_substring_in(safe_string_arena_t, s_string_t, unsigned long int, unsigned long int);
+
 /*!
  * @brief Extracts a string from within another string. Using only a starting position,
  * extraction is performed using the length of the string as an upper bound.
@@ -57,4 +71,26 @@ extern s_string_t safe_string_substring(s_string_t str, unsigned long int, unsig
  */
 extern s_string_t safe_string_substring_auto(s_string_t str, unsigned long int);
 
+/*!
+ * @brief Refers to a string within another string without copying it.
+ * @param str source string
+ * @param offset starting index of the view
+ * @param limit ending index of the view
+ * @return A view of the substring defined by the boundaries 'offset' and
+ * 'limit', or an invalid view if there was an error.
+ * @note Sets the error value indicating success or failure.
+ */
+extern s_string_view_t safe_string_substring_view(s_string_t, unsigned long int, unsigned long int);
+
+/*!
+ * @brief Refers to a string within another string without copying it. Using only
+ * a starting position, the length of the string is used as an upper bound.
+ * @param str source string
+ * @param offset starting index of the view
+ * @return A view of the substring defined by the boundary 'offset' and the length
+ * of the source string, or an invalid view if there was an error.
+ * @note Sets the error value indicating success or failure.
+ */
+extern s_string_view_t safe_string_substring_auto_view(s_string_t, unsigned long int);
+
 #endif
@@ -36,25 +36,6 @@
 #include "utility.h"
 #include "macro.h"
 
-/*!
- * @brief (INTERNAL) Compares two single characters irrespective of their case
- * @param c1 character to compare
- * @param c2 character to compare
- * @return Computes the result of c1 - c2 where c1 and c2 are the same case
- * given they are from the standard ASCII alphabet
- */
-static inline int _safe_string_char_case_compare(char c1, char c2)
-{
-	if(!((c1 == c2) || (c1 < 'A' || c1 > 'z' || c2 < 'A' || c2 > 'z'))) {
-		if(c1 <= 'Z') {
-			c1 += 32;
-		} else {
-			c1 -= 32;
-		}
-	}
-	return(c1 - c2);
-}
-
 /*!
  * @brief Compares a substring of one string with another string using an upper
  * limit irrespective of their case
@@ -69,15 +50,14 @@ int safe_string_substring_case_compare_limit(s_string_t str1, s_string_t str2, u
 {
 	if(safe_string_valid(str1) && safe_string_valid(str2)) {
 		if(safe_string_length(str1) > offset && limit >= offset) {
+			unsigned long int length1 = str1->s_length - 1, length2 = str2->s_length - 1, span = 0;
 			int diff = 0;
-			unsigned long int i = 0;
-			limit = MIN(limit, MAX(safe_string_length(str1), safe_string_length(str2) + offset));
 
-			while((offset < limit) && !diff && !safe_string_error()) {
-				diff = _safe_string_char_case_compare(safe_string_index(str1, offset++), safe_string_index(str2, i++));
-			}
+			limit = MIN(limit, MAX(length1, length2 + offset)) - offset;
+			span = MIN(limit, MIN(length1 - offset, length2) + 1); /* the terminator of the shorter range is the last character both hold */
+			diff = _safe_string_range_case_compare(str1->s_string + offset, str2->s_string, span);
 
-			safe_string_set_error(safe_string_error());
+			safe_string_set_error((diff || span == limit) ? SAFE_STRING_ERROR_NO_ERROR : SAFE_STRING_ERROR_INDEX_BOUNDS);
 			return(diff);
 		} else {
 			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
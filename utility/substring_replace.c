@@ -61,25 +61,9 @@ s_string_t safe_string_substring_replace_char(s_string_t str, unsigned long int
 s_string_t safe_string_substring_replace_limit_char(s_string_t str, unsigned long int start, unsigned long int end, const char *old, const char *new, unsigned long int limit)
 {
 	if(old && new) {
-		s_string_t oldt, newt;
+		_s_string_t oldt, newt;
 
-		oldt = safe_string_new(old);
-
-		if(safe_string_valid(oldt)) {
-			newt = safe_string_new(new);
-			if(safe_string_valid(newt)) {
-				s_string_t retn = safe_string_substring_replace_limit(str, start, end, oldt, newt, limit);
-				safe_string_delete(oldt); safe_string_delete(newt);
-				return(retn);
-			} else {
-				safe_string_delete(oldt);
-				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-				return(SAFE_STRING_INVALID);
-			}
-		} else {
-			safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
-			return(SAFE_STRING_INVALID);
-		}
+		return(safe_string_substring_replace_limit(str, start, end, _safe_string_wrap(&oldt, old), _safe_string_wrap(&newt, new), limit));
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
 		return(SAFE_STRING_INVALID);
@@ -95,7 +79,7 @@ s_string_t safe_string_substring_replace_limit_char(s_string_t str, unsigned lon
  * @param old string to be replaced
  * @param new string to replace
  */
-s_string_t safe_string_substring_replace(s_string_t str, unsigned long int start, unsigned long int end, s_string_t old, s_string_t new)
+s_string_t (safe_string_substring_replace)(s_string_t str, unsigned long int start, unsigned long int end, s_string_t old, s_string_t new)
 {
 	return(safe_string_substring_replace_limit(str, start, end, old, new, 0));
 }
@@ -109,7 +93,7 @@ s_string_t safe_string_substring_replace(s_string_t str, unsigned long int start
  * @param new string to replace
  * @param limit maximum amount of replacements to be made (0 for unlimited)
  */
-s_string_t safe_string_substring_replace_limit(s_string_t str, unsigned long int start, unsigned long int end, s_string_t old, s_string_t new, unsigned long int limit)
+s_string_t (safe_string_substring_replace_limit)(s_string_t str, unsigned long int start, unsigned long int end, s_string_t old, s_string_t new, unsigned long int limit)
 {
 	if(safe_string_valid(str) && safe_string_valid(old) && safe_string_valid(new)) {
 		unsigned long int vector[2], amount;
@@ -78,4 +78,20 @@ extern s_string_t safe_string_substring_replace(s_string_t, unsigned long int, u
  */
 extern s_string_t safe_string_substring_replace_limit(s_string_t, unsigned long int, unsigned long int, s_string_t, s_string_t, unsigned long int);
 
+#ifdef SAFE_STRING_GENERIC
+/*!
+ * @brief Replaces strings within a substring, with the pattern and replacement
+ * given either both as strings or both as C strings (dispatched to
+ * safe_string_substring_replace_char for C strings, without allocating)
+ */
+#define safe_string_substring_replace(str, start, end, old, new) _safe_string_generic(old, safe_string_substring_replace)(str, start, end, old, new)
+
+/*!
+ * @brief Replaces an amount of strings within a substring, with the pattern and
+ * replacement given either both as strings or both as C strings (dispatched to
+ * safe_string_substring_replace_limit_char for C strings, without allocating)
+ */
+#define safe_string_substring_replace_limit(str, start, end, old, new, limit) _safe_string_generic(old, safe_string_substring_replace_limit)(str, start, end, old, new, limit)
+#endif
+
 #endif
@@ -36,30 +36,6 @@
 #include "universal.h"
 #include "macro.h"
 
-/*!
- * @brief Internal function to check if specific character is in a given set
- * @param c character to test for
- * @param set set to test if character is in
- * @return 1 if character is in set, 0 otherwise
- */
-static inline int _char_in_set(char c, s_string_t set)
-{
-	if(safe_string_valid(set)) {
-		unsigned long int i = 0;
-
-		for(i = 0; i < safe_string_length(set); i++) {
-			if(c == safe_string_index(set, i)) {
-				return(1);
-			}
-		}
-		
-		return(0);
-	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return(0);
-	}
-}
-
 /*!
  * @brief Splits input string into tokens by splitting on elements specified by the elements of
  * another string.
@@ -85,15 +61,9 @@ s_strings_t safe_string_token_split_char(s_string_t str, const char *tokens, uns
 s_strings_t safe_string_token_split_limit_char(s_string_t str, const char *tokens, unsigned long int limit, unsigned long int *count)
 {
 	if(tokens) {
-		s_string_t temp = safe_string_new(tokens);
+		_s_string_t temp;
 
-		if(!safe_string_error()) {
-			s_strings_t retn = safe_string_token_split_limit(str, temp, limit, count);
-			safe_string_delete(temp);
-			return(retn);
-		} else {
-			return(SAFE_STRING_INVALID);
-		}
+		return(safe_string_token_split_limit(str, _safe_string_wrap(&temp, tokens), limit, count));
 	} else {
 		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
 		return(SAFE_STRING_INVALID);
@@ -108,7 +78,7 @@ s_strings_t safe_string_token_split_limit_char(s_string_t str, const char *token
  * @param count the amount of elements created by splitting
  * @return An array of strings created by splitting the source string.
  */
-s_strings_t safe_string_token_split(s_string_t str, s_string_t tokens, unsigned long int *count)
+s_strings_t (safe_string_token_split)(s_string_t str, s_string_t tokens, unsigned long int *count)
 {
 	return(safe_string_token_split_limit(str, tokens, 0, count));
 }
@@ -122,43 +92,50 @@ s_strings_t safe_string_token_split(s_string_t str, s_string_t tokens, unsigned
  * @param count the amount of elements created by splitting
  * @return An array of strings created by splitting the source string.
  */
-s_strings_t safe_string_token_split_limit(s_string_t str, s_string_t tokens, unsigned long int limit, unsigned long int *count)
+s_strings_t (safe_string_token_split_limit)(s_string_t str, s_string_t tokens, unsigned long int limit, unsigned long int *count)
 {
 	if(safe_string_valid(str) && safe_string_valid(tokens) && count) {
 		unsigned long int i = 0, j = 0, found = 0, length = safe_string_length(str);
-		unsigned long int *offsets = (unsigned long int *)malloc(sizeof(unsigned long int) * safe_string_length(str));
+		unsigned long int *offsets = (unsigned long int *)_safe_string_malloc(sizeof(unsigned long int) * safe_string_length(str));
+		unsigned char table[_S_RANGE_TABLE_SIZE];
 
 		if(offsets) {
-			while((i < length) && ((found < limit) || !limit)) { /* if limit = 0, then we don't care how many we find */
-				if(_char_in_set(safe_string_index(str, i), tokens)) {
-					offsets[found++] = i;
+			_safe_string_range_table(table, tokens->s_string, tokens->s_length - 1);
+
+			while((found < limit) || !limit) { /* if limit = 0, then we don't care how many we find */
+				if((i += _safe_string_range_scan(str->s_string + i, length - i, table, 1)) >= length) {
+					break;
 				}
-				i++;
+				offsets[found++] = i++;
 			}
 				
 
-			s_strings_t retn = (s_strings_t)calloc(found + 2, sizeof(s_string_t)); /* maximum size */
+			s_strings_t retn = (s_strings_t)_safe_string_calloc(found + 2, sizeof(s_string_t)); /* maximum size */
 
 			if(retn) {
+				_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, (found + 2) * sizeof(s_string_t));
 
 				for(i = 0; i < found; j = offsets[i] + 1, i++) {
-					retn[i] = safe_string_substring(str, j, offsets[i]);
+					retn[i] = _safe_string_allocate_copy_in(SAFE_STRING_INVALID, str->s_string + j, offsets[i] - j);
 				}
 
-				retn[i++] = (j >= safe_string_length(str)) ? safe_string_new("") :  safe_string_substring(str, j, safe_string_length(str)); /* always needed */
-				if(realloc(retn, i * sizeof(s_string_t))) {
-					free(offsets);
+				retn[i++] = _safe_string_allocate_copy_in(SAFE_STRING_INVALID, str->s_string + j, (j >= safe_string_length(str)) ? 0 : safe_string_length(str) - j); /* always needed */
+				s_strings_t shrunk = (s_strings_t)_safe_string_realloc(retn, i * sizeof(s_string_t));
+
+				if(shrunk) {
+					_safe_string_free(offsets);
 					*count = i;
 					safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-					return(retn);
+					return(shrunk);
 				} else {
 					*count = SAFE_STRING_EMPTY;
-					free(offsets);
-					safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+					_safe_string_free(offsets);
+					safe_string_array_delete(retn, i);
+					safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 					return(SAFE_STRING_INVALID);
 				}
 			} else {
-				free(offsets);
+				_safe_string_free(offsets);
 				safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
 				return(SAFE_STRING_INVALID);
 			}
@@ -171,3 +148,33 @@ s_strings_t safe_string_token_split_limit(s_string_t str, s_string_t tokens, uns
 		return(SAFE_STRING_INVALID);
 	}
 }
+
+/*!
+ * @brief Splits input string into a vector of at most 'limit' tokens by splitting
+ * on elements specified by the elements of another string.
+ * @param str source string
+ * @param tokens the string containing the characters to split on
+ * @param limit the maximum amount of splits to make, 0 for unlimited splits
+ * @return Vector of strings created by splitting the source string, or
+ * SAFE_STRING_INVALID if there was an error
+ */
+safe_strings_vec_t safe_string_token_split_limit_vec(s_string_t str, s_string_t tokens, unsigned long int limit)
+{
+	unsigned long int count = 0;
+	s_strings_t strs = safe_string_token_split_limit(str, tokens, limit, &count);
+
+	return(_safe_strings_vec_adopt(strs, count));
+}
+
+/*!
+ * @brief Splits input string into a vector of tokens by splitting on elements
+ * specified by the elements of another string.
+ * @param str source string
+ * @param tokens the string containing the characters to split on
+ * @return Vector of strings created by splitting the source string, or
+ * SAFE_STRING_INVALID if there was an error
+ */
+safe_strings_vec_t safe_string_token_split_vec(s_string_t str, s_string_t tokens)
+{
+	return(safe_string_token_split_limit_vec(str, tokens, 0));
+}
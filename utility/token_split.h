@@ -76,4 +76,41 @@ extern s_strings_t safe_string_token_split(s_string_t, s_string_t, unsigned long
  */
 extern s_strings_t safe_string_token_split_limit(s_string_t, s_string_t, unsigned long int, unsigned long int *);
 
+/*!
+ * @brief Splits input string into a vector of at most 'limit' tokens by splitting
+ * on elements specified by the elements of another string.
+ * @param str source string
+ * @param tokens the string containing the characters to split on
+ * @param limit the maximum amount of splits to make, 0 for unlimited splits
+ * @return Vector of strings created by splitting the source string, or
+ * SAFE_STRING_INVALID if there was an error
+ */
+extern safe_strings_vec_t safe_string_token_split_limit_vec(s_string_t, s_string_t, unsigned long int);
+
+/*!
+ * @brief Splits input string into a vector of tokens by splitting on elements
+ * specified by the elements of another string.
+ * @param str source string
+ * @param tokens the string containing the characters to split on
+ * @return Vector of strings created by splitting the source string, or
+ * SAFE_STRING_INVALID if there was an error
+ */
+extern safe_strings_vec_t safe_string_token_split_vec(s_string_t, s_string_t);
+
+#ifdef SAFE_STRING_GENERIC
+/*!
+ * @brief Splits a string into tokens upon characters given either as a string
+ * or a C string (dispatched to safe_string_token_split_char for C strings,
+ * without allocating)
+ */
+#define safe_string_token_split(str, tokens, count) _safe_string_generic(tokens, safe_string_token_split)(str, tokens, count)
+
+/*!
+ * @brief Splits a string into at most 'limit' tokens upon characters given
+ * either as a string or a C string (dispatched to
+ * safe_string_token_split_limit_char for C strings, without allocating)
+ */
+#define safe_string_token_split_limit(str, tokens, limit, count) _safe_string_generic(tokens, safe_string_token_split_limit)(str, tokens, limit, count)
+#endif
+
 #endif
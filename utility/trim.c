@@ -30,41 +30,12 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <string.h> /* strlen */
 #include "types/types.h"
 #include "universal.h"
 #include "utility.h"
 #include "macro.h"
 
-/*!
- * @brief Internal function to check if specific character is in a given set
- * @param c character to test for
- * @param set set to test if character is in
- * @return 1 if character is in set, 0 otherwise
- */
-static inline int _char_in_set(char c, const char *set)
-{
-	if(set) {
-		unsigned long int i = 0, length = 0;
-
-		while(*(set + length)) {
-			length++;
-		}
-
-		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
-
-		for(i = 0; i < length; i++) {
-			if(c == set[i]) {
-				return(1);
-			}
-		}
-		
-		return(0);
-	} else {
-		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
-		return(0);
-	}
-}
-
 /*!
  * @brief Removes at most a given amount of characters specified by a given set
  * from the left (beginning) of a given string.
@@ -77,17 +48,13 @@ static inline int _char_in_set(char c, const char *set)
 s_string_t safe_string_ltrim_set_limit(s_string_t str, const char *set, unsigned long int limit)
 {
 	if(safe_string_valid(str) && set) {
-		unsigned long int i = 0;
+		unsigned long int i = 0, length = str->s_length - 1;
+		unsigned char table[_S_RANGE_TABLE_SIZE];
 		s_string_t retn;
 
-		limit = MIN(limit, safe_string_length(str));
-		
-		while(i < limit || !limit) {
-			if(!_char_in_set(safe_string_index(str, i), set)) {
-				break;
-			}
-			i++;
-		}
+		limit = limit ? MIN(limit, length) : length;
+		_safe_string_range_table(table, set, strlen(set));
+		i = _safe_string_range_scan(str->s_string, limit, table, 0);
 
 		retn = safe_string_substring(str, i, safe_string_length(str));
 
@@ -115,17 +82,13 @@ s_string_t safe_string_ltrim_set_limit(s_string_t str, const char *set, unsigned
 s_string_t safe_string_rtrim_set_limit(s_string_t str, const char *set, unsigned long int limit)
 {
 	if(safe_string_valid(str) && set) {
-		unsigned long int i = 0, length = safe_string_length(str);
+		unsigned long int i = 0, length = str->s_length - 1;
+		unsigned char table[_S_RANGE_TABLE_SIZE];
 		s_string_t retn;
 
-		limit = MIN(limit, length);
-		
-		while(i < limit || !limit) {
-			if(!_char_in_set(safe_string_index(str, (length - i) - 1), set)) {
-				break;
-			}
-			i++;
-		}
+		limit = limit ? MIN(limit, length) : length;
+		_safe_string_range_table(table, set, strlen(set));
+		i = _safe_string_range_scan_reverse(str->s_string + length - limit, limit, table, 0);
 
 		retn = safe_string_substring(str, 0, length - i);
 
@@ -153,24 +116,14 @@ s_string_t safe_string_rtrim_set_limit(s_string_t str, const char *set, unsigned
 s_string_t safe_string_trim_set_limit(s_string_t str, const char *set, unsigned long int limit)
 {
 	if(safe_string_valid(str) && set) {
-		unsigned long int i = 0, j = 0, length = safe_string_length(str);
+		unsigned long int i = 0, j = 0, length = str->s_length - 1;
+		unsigned char table[_S_RANGE_TABLE_SIZE];
 		s_string_t retn;
 
-		limit = MIN(limit, length);
-
-		while(i < limit || !limit) {
-			if(!_char_in_set(safe_string_index(str, i), set)) {
-				break;
-			}
-			i++;
-		}
-		
-		while(j < limit || !limit) {
-			if(!_char_in_set(safe_string_index(str, (length - j) - 1), set)) {
-				break;
-			}
-			j++;
-		}
+		limit = limit ? MIN(limit, length) : length;
+		_safe_string_range_table(table, set, strlen(set));
+		i = _safe_string_range_scan(str->s_string, limit, table, 0);
+		j = _safe_string_range_scan_reverse(str->s_string + length - limit, limit, table, 0);
 
 		retn = safe_string_substring(str, i, length - j);
 
@@ -295,3 +248,97 @@ s_string_t safe_string_trim(s_string_t str)
 {
 	return(safe_string_trim_set_limit(str, " \t\n\r\v", 0));
 }
+
+/*!
+ * @brief Narrows a view to exclude the characters specified by a given set from
+ * the left (beginning), without copying.
+ * @param view source view
+ * @param set set of characters to be excluded
+ * @return The trimmed view, or an invalid view if there was an error.
+ */
+s_string_view_t safe_string_ltrim_set_view(s_string_view_t view, const char *set)
+{
+	if(safe_string_view_valid(view) && set) {
+		unsigned char table[_S_RANGE_TABLE_SIZE];
+		unsigned long int i = 0;
+
+		_safe_string_range_table(table, set, strlen(set));
+		i = _safe_string_range_scan(view.v_string, view.v_length, table, 0);
+		view.v_string += i;
+		view.v_length -= i;
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(view);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(_safe_string_view_make(SAFE_STRING_INVALID, SAFE_STRING_EMPTY));
+	}
+}
+
+/*!
+ * @brief Narrows a view to exclude the characters specified by a given set from
+ * the right (ending), without copying.
+ * @param view source view
+ * @param set set of characters to be excluded
+ * @return The trimmed view, or an invalid view if there was an error.
+ */
+s_string_view_t safe_string_rtrim_set_view(s_string_view_t view, const char *set)
+{
+	if(safe_string_view_valid(view) && set) {
+		unsigned char table[_S_RANGE_TABLE_SIZE];
+
+		_safe_string_range_table(table, set, strlen(set));
+		view.v_length -= _safe_string_range_scan_reverse(view.v_string, view.v_length, table, 0);
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(view);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(_safe_string_view_make(SAFE_STRING_INVALID, SAFE_STRING_EMPTY));
+	}
+}
+
+/*!
+ * @brief Narrows a view to exclude the characters specified by a given set from
+ * the left and right (start and ending), without copying.
+ * @param view source view
+ * @param set set of characters to be excluded
+ * @return The trimmed view, or an invalid view if there was an error.
+ */
+s_string_view_t safe_string_trim_set_view(s_string_view_t view, const char *set)
+{
+	return(safe_string_rtrim_set_view(safe_string_ltrim_set_view(view, set), set));
+}
+
+/*!
+ * @brief Narrows a view to exclude white space characters from the left (start),
+ * without copying.
+ * @param view source view
+ * @return The trimmed view.
+ */
+s_string_view_t safe_string_ltrim_view(s_string_view_t view)
+{
+	return(safe_string_ltrim_set_view(view, " \t\n\r\v"));
+}
+
+/*!
+ * @brief Narrows a view to exclude white space characters from the right
+ * (ending), without copying.
+ * @param view source view
+ * @return The trimmed view.
+ */
+s_string_view_t safe_string_rtrim_view(s_string_view_t view)
+{
+	return(safe_string_rtrim_set_view(view, " \t\n\r\v"));
+}
+
+/*!
+ * @brief Narrows a view to exclude white space characters from the left and
+ * right (start and ending), without copying.
+ * @param view source view
+ * @return The trimmed view.
+ */
+s_string_view_t safe_string_trim_view(s_string_view_t view)
+{
+	return(safe_string_trim_set_view(view, " \t\n\r\v"));
+}
@@ -145,3 +145,54 @@ extern s_string_t safe_string_rtrim(s_string_t str);
  * @return The trimmed string.
  */
 extern s_string_t safe_string_trim(s_string_t str);
+
+/*!
+ * @brief Narrows a view to exclude the characters specified by a given set from
+ * the left (beginning), without copying.
+ * @param view source view
+ * @param set set of characters to be excluded
+ * @return The trimmed view, or an invalid view if there was an error.
+ */
+extern s_string_view_t safe_string_ltrim_set_view(s_string_view_t, const char *);
+
+/*!
+ * @brief Narrows a view to exclude the characters specified by a given set from
+ * the right (ending), without copying.
+ * @param view source view
+ * @param set set of characters to be excluded
+ * @return The trimmed view, or an invalid view if there was an error.
+ */
+extern s_string_view_t safe_string_rtrim_set_view(s_string_view_t, const char *);
+
+/*!
+ * @brief Narrows a view to exclude the characters specified by a given set from
+ * the left and right (start and ending), without copying.
+ * @param view source view
+ * @param set set of characters to be excluded
+ * @return The trimmed view, or an invalid view if there was an error.
+ */
+extern s_string_view_t safe_string_trim_set_view(s_string_view_t, const char *);
+
+/*!
+ * @brief Narrows a view to exclude white space characters from the left (start),
+ * without copying.
+ * @param view source view
+ * @return The trimmed view.
+ */
+extern s_string_view_t safe_string_ltrim_view(s_string_view_t);
+
+/*!
+ * @brief Narrows a view to exclude white space characters from the right
+ * (ending), without copying.
+ * @param view source view
+ * @return The trimmed view.
+ */
+extern s_string_view_t safe_string_rtrim_view(s_string_view_t);
+
+/*!
+ * @brief Narrows a view to exclude white space characters from the left and
+ * right (start and ending), without copying.
+ * @param view source view
+ * @return The trimmed view.
+ */
+extern s_string_view_t safe_string_trim_view(s_string_view_t);
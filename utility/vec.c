@@ -0,0 +1,380 @@
+/*!
+ * @file utility/vec.c
+ * @brief Implementation of growable vectors of strings
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memmove */
+#include "types/types.h"
+#include "universal.h"
+#include "utility.h"
+#include "macro.h"
+
+#define _S_VEC_CAPACITY_MINIMUM 8 /*!< (INTERNAL) Smallest array allocated when a vector grows */
+
+/*!
+ * @brief (INTERNAL) Changes the size of a vector's array
+ * @param vec destination vector
+ * @param capacity amount of strings the array should hold (must be at least the
+ * amount held)
+ * @return Non-zero on success, zero otherwise
+ * @note Sets the error variable indicating success or failure
+ */
+static int _safe_strings_vec_reallocate(safe_strings_vec_t vec, unsigned long int capacity)
+{
+	s_strings_t strings = SAFE_STRING_INVALID;
+
+	if(capacity > ~0UL / sizeof(s_string_t) || !(strings = (s_strings_t)_safe_string_realloc(vec->v_strings, capacity * sizeof(s_string_t)))) {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_EMPTY);
+	}
+
+	_safe_string_stats_allocate(SAFE_STRING_STATS_ARRAY, capacity * sizeof(s_string_t));
+	vec->v_strings = strings;
+	vec->v_capacity = capacity;
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief (INTERNAL) Ensures a vector has room for at least one more string; the
+ * array at least doubles in size when it has to be reallocated, making repeated
+ * pushes amortized O(1)
+ * @param vec destination vector
+ * @return Non-zero on success, zero otherwise
+ * @note Sets the error variable indicating success or failure
+ */
+static int _safe_strings_vec_grow(safe_strings_vec_t vec)
+{
+	if(vec->v_count == vec->v_capacity) {
+		return(_safe_strings_vec_reallocate(vec, MAX(vec->v_capacity * 2, _S_VEC_CAPACITY_MINIMUM)));
+	}
+
+	return(!SAFE_STRING_EMPTY);
+}
+
+/*!
+ * @brief (INTERNAL) Creates a vector which takes ownership of an array of
+ * strings, without copying it
+ * @param strs array to adopt (allocated from the heap, as returned by the split
+ * functions; if SAFE_STRING_INVALID the error value is left untouched)
+ * @param count amount of strings within the array
+ * @return The newly created vector, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the array is deleted
+ */
+safe_strings_vec_t _safe_strings_vec_adopt(s_strings_t strs, unsigned long int count)
+{
+	safe_strings_vec_t retn;
+	unsigned long int i = 0;
+
+	if(!strs) {
+		return(SAFE_STRING_INVALID); /* use the error code from the function creating the array */
+	}
+
+	if(!(retn = (safe_strings_vec_t)_safe_string_malloc(sizeof(struct _s_strings_vec_t)))) {
+		safe_string_array_delete(strs, count);
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	}
+
+	retn->v_strings = strs;
+	retn->v_count = count;
+	retn->v_capacity = count;
+	retn->v_invalid = 0;
+
+	for(i = 0; i < count; i++) {
+		if(!safe_string_valid(strs[i])) {
+			retn->v_invalid++;
+		}
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+	return(retn);
+}
+
+/*!
+ * @brief Creates an empty vector of strings
+ * @param capacity amount of strings to reserve room for
+ * @return The newly created vector, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+safe_strings_vec_t safe_strings_vec_new(unsigned long int capacity)
+{
+	safe_strings_vec_t retn = (safe_strings_vec_t)_safe_string_malloc(sizeof(struct _s_strings_vec_t));
+
+	if(retn) {
+		memset(retn, 0, sizeof(struct _s_strings_vec_t));
+
+		if(capacity && !_safe_strings_vec_reallocate(retn, capacity)) {
+			_safe_string_free(retn);
+			return(SAFE_STRING_INVALID); /* use the error code from _safe_strings_vec_reallocate */
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(retn);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_MEM_ALLOC);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Deletes a vector along with every string within it
+ * @param vec vector to delete
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_strings_vec_delete(safe_strings_vec_t vec)
+{
+	if(vec) {
+		safe_string_array_delete(vec->v_strings, vec->v_count);
+		_safe_string_free(vec);
+	}
+
+	safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+}
+
+/*!
+ * @brief Gets the amount of strings within a vector
+ * @param vec source vector
+ * @return The amount of strings, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+unsigned long int safe_strings_vec_count(safe_strings_vec_t vec)
+{
+	if(vec) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(vec->v_count);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_EMPTY);
+	}
+}
+
+/*!
+ * @brief Accesses a string within a vector, which remains owned by the vector
+ * @param vec source vector
+ * @param index position of the string within the vector
+ * @return The string (which may itself be invalid), or SAFE_STRING_INVALID if
+ * there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_strings_vec_index(safe_strings_vec_t vec, unsigned long int index)
+{
+	if(vec) {
+		if(index < vec->v_count) {
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(vec->v_strings[index]);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Accesses the array of strings held by a vector, so it can be passed to
+ * functions taking an array and a count
+ * @param vec source vector
+ * @return The array, which remains owned by the vector and valid until it is
+ * next modified, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The array is read-only: storing into it bypasses the count of invalid
+ * strings behind safe_strings_vec_valid, use the vector's functions instead
+ */
+s_strings_t safe_strings_vec_array(safe_strings_vec_t vec)
+{
+	if(vec) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(vec->v_strings);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Tests if every string within a vector is valid, without visiting them
+ * @param vec source vector
+ * @return Non-zero if the vector and every string within it are valid, zero
+ * otherwise
+ * @note Relies on the strings only being changed through the vector's functions
+ */
+int safe_strings_vec_valid(safe_strings_vec_t vec)
+{
+	return(vec && !vec->v_invalid);
+}
+
+/*!
+ * @brief Reserves room within a vector for at least a given amount of strings
+ * @param vec destination vector
+ * @param capacity amount of strings the vector should be able to hold without
+ * reallocating
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_strings_vec_reserve(safe_strings_vec_t vec, unsigned long int capacity)
+{
+	if(vec) {
+		if(capacity > vec->v_capacity && !_safe_strings_vec_reallocate(vec, capacity)) {
+			return; /* carry the error value */
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Inserts a string into a vector, moving the strings after it along
+ * @param vec destination vector
+ * @param index position to insert the string at (at most the amount of strings)
+ * @param str string to insert (the vector takes ownership of it, it may be
+ * invalid)
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the string remains owned by the caller
+ */
+void safe_strings_vec_insert(safe_strings_vec_t vec, unsigned long int index, s_string_t str)
+{
+	if(vec) {
+		if(index > vec->v_count) {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return;
+		} else if(!_safe_strings_vec_grow(vec)) {
+			return; /* carry the error value */
+		}
+
+		memmove(vec->v_strings + index + 1, vec->v_strings + index, (vec->v_count - index) * sizeof(s_string_t));
+		vec->v_strings[index] = str;
+		vec->v_count++;
+
+		if(!safe_string_valid(str)) {
+			vec->v_invalid++;
+		}
+
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return;
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return;
+	}
+}
+
+/*!
+ * @brief Appends a string to the end of a vector
+ * @param vec destination vector
+ * @param str string to append (the vector takes ownership of it, it may be
+ * invalid)
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the string remains owned by the caller
+ */
+void safe_strings_vec_push(safe_strings_vec_t vec, s_string_t str)
+{
+	if(vec) {
+		safe_strings_vec_insert(vec, vec->v_count, str);
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+	}
+}
+
+/*!
+ * @brief Removes a string from a vector, handing it back to the caller
+ * @param vec destination vector
+ * @param index position of the string within the vector
+ * @return The string (now owned by the caller), or SAFE_STRING_INVALID if there
+ * was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_strings_vec_remove(safe_strings_vec_t vec, unsigned long int index)
+{
+	if(vec) {
+		if(index < vec->v_count) {
+			s_string_t retn = vec->v_strings[index];
+
+			memmove(vec->v_strings + index, vec->v_strings + index + 1, (vec->v_count - index - 1) * sizeof(s_string_t));
+			vec->v_count--;
+
+			if(!safe_string_valid(retn)) {
+				vec->v_invalid--;
+			}
+
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(retn);
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Removes the last string from a vector, handing it back to the caller
+ * @param vec destination vector
+ * @return The string (now owned by the caller), or SAFE_STRING_INVALID if there
+ * was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_strings_vec_pop(safe_strings_vec_t vec)
+{
+	if(vec) {
+		if(vec->v_count) {
+			return(safe_strings_vec_remove(vec, vec->v_count - 1));
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INDEX_BOUNDS);
+			return(SAFE_STRING_INVALID);
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}
+
+/*!
+ * @brief Removes a string from a vector and deletes it
+ * @param vec destination vector
+ * @param index position of the string within the vector
+ * @note Sets the error variable indicating success or failure
+ */
+void safe_strings_vec_erase(safe_strings_vec_t vec, unsigned long int index)
+{
+	s_string_t str = safe_strings_vec_remove(vec, index);
+
+	if(!safe_string_error()) {
+		safe_string_delete(str);
+	}
+}
@@ -0,0 +1,161 @@
+/*!
+ * @file utility/vec.h
+ * @brief Header for implementation of growable vectors of strings
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _SAFE_STRING_UTILITY_VEC_H_
+#define _SAFE_STRING_UTILITY_VEC_H_
+
+#include "types/types.h"
+
+/*!
+ * @brief (INTERNAL) Creates a vector which takes ownership of an array of
+ * strings, without copying it
+ * @param strs array to adopt (allocated from the heap, as returned by the split
+ * functions; if SAFE_STRING_INVALID the error value is left untouched)
+ * @param count amount of strings within the array
+ * @return The newly created vector, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the array is deleted
+ */
+extern safe_strings_vec_t _safe_strings_vec_adopt(s_strings_t, unsigned long int);
+
+/*!
+ * @brief Creates an empty vector of strings
+ * @param capacity amount of strings to reserve room for
+ * @return The newly created vector, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern safe_strings_vec_t safe_strings_vec_new(unsigned long int);
+
+/*!
+ * @brief Deletes a vector along with every string within it
+ * @param vec vector to delete
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_strings_vec_delete(safe_strings_vec_t);
+
+/*!
+ * @brief Gets the amount of strings within a vector
+ * @param vec source vector
+ * @return The amount of strings, or SAFE_STRING_EMPTY if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern unsigned long int safe_strings_vec_count(safe_strings_vec_t);
+
+/*!
+ * @brief Accesses a string within a vector, which remains owned by the vector
+ * @param vec source vector
+ * @param index position of the string within the vector
+ * @return The string (which may itself be invalid), or SAFE_STRING_INVALID if
+ * there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_strings_vec_index(safe_strings_vec_t, unsigned long int);
+
+/*!
+ * @brief Accesses the array of strings held by a vector, so it can be passed to
+ * functions taking an array and a count
+ * @param vec source vector
+ * @return The array, which remains owned by the vector and valid until it is
+ * next modified, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ * @note The array is read-only: storing into it bypasses the count of invalid
+ * strings behind safe_strings_vec_valid, use the vector's functions instead
+ */
+extern s_strings_t safe_strings_vec_array(safe_strings_vec_t);
+
+/*!
+ * @brief Tests if every string within a vector is valid, without visiting them
+ * @param vec source vector
+ * @return Non-zero if the vector and every string within it are valid, zero
+ * otherwise
+ * @note Relies on the strings only being changed through the vector's functions
+ */
+extern int safe_strings_vec_valid(safe_strings_vec_t);
+
+/*!
+ * @brief Reserves room within a vector for at least a given amount of strings
+ * @param vec destination vector
+ * @param capacity amount of strings the vector should be able to hold without
+ * reallocating
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_strings_vec_reserve(safe_strings_vec_t, unsigned long int);
+
+/*!
+ * @brief Inserts a string into a vector, moving the strings after it along
+ * @param vec destination vector
+ * @param index position to insert the string at (at most the amount of strings)
+ * @param str string to insert (the vector takes ownership of it, it may be
+ * invalid)
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the string remains owned by the caller
+ */
+extern void safe_strings_vec_insert(safe_strings_vec_t, unsigned long int, s_string_t);
+
+/*!
+ * @brief Appends a string to the end of a vector
+ * @param vec destination vector
+ * @param str string to append (the vector takes ownership of it, it may be
+ * invalid)
+ * @note Sets the error variable indicating success or failure
+ * @note On failure the string remains owned by the caller
+ */
+extern void safe_strings_vec_push(safe_strings_vec_t, s_string_t);
+
+/*!
+ * @brief Removes a string from a vector, handing it back to the caller
+ * @param vec destination vector
+ * @param index position of the string within the vector
+ * @return The string (now owned by the caller), or SAFE_STRING_INVALID if there
+ * was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_strings_vec_remove(safe_strings_vec_t, unsigned long int);
+
+/*!
+ * @brief Removes the last string from a vector, handing it back to the caller
+ * @param vec destination vector
+ * @return The string (now owned by the caller), or SAFE_STRING_INVALID if there
+ * was an error
+ * @note Sets the error variable indicating success or failure
+ */
+extern s_string_t safe_strings_vec_pop(safe_strings_vec_t);
+
+/*!
+ * @brief Removes a string from a vector and deletes it
+ * @param vec destination vector
+ * @param index position of the string within the vector
+ * @note Sets the error variable indicating success or failure
+ */
+extern void safe_strings_vec_erase(safe_strings_vec_t, unsigned long int);
+
+#endif
@@ -0,0 +1,124 @@
+/*!
+ * @file utility/view.c
+ * @brief Implementation of non-owning string views
+ * @author Sam Thomas <s@ghost.sh>
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Sam Thomas <s@ghost.sh>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h> /* memcpy, strlen */
+#include "types/types.h"
+#include "universal.h"
+#include "utility.h"
+#include "macro.h"
+
+/*!
+ * @brief Creates a view of the whole of a string
+ * @param str source string
+ * @return A view of the string's characters, or an invalid view if there was an
+ * error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_view_t safe_string_view(s_string_t str)
+{
+	if(safe_string_valid(str)) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(_safe_string_view_make(str->s_string, safe_string_length(str)));
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(_safe_string_view_make(SAFE_STRING_INVALID, SAFE_STRING_EMPTY));
+	}
+}
+
+/*!
+ * @brief Creates a view of a C string
+ * @param str source C string
+ * @return A view of the C string's characters (excluding the terminator), or an
+ * invalid view if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_view_t safe_string_view_char(const char *str)
+{
+	if(str) {
+		safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+		return(_safe_string_view_make(str, strlen(str)));
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(_safe_string_view_make(SAFE_STRING_INVALID, SAFE_STRING_EMPTY));
+	}
+}
+
+/*!
+ * @brief Creates a view of a range within another view, the bounds follow those
+ * of safe_string_substring except that the range may start at the end of the
+ * view (giving an empty view)
+ * @param view source view
+ * @param offset starting index of the range
+ * @param limit ending index of the range
+ * @return A view of the range, or an invalid view if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_view_t safe_string_view_slice(s_string_view_t view, unsigned long int offset, unsigned long int limit)
+{
+	if(safe_string_view_valid(view)) {
+		if(offset <= view.v_length && offset <= limit) {
+			limit = MIN(view.v_length, limit);
+
+			safe_string_set_error(SAFE_STRING_ERROR_NO_ERROR);
+			return(_safe_string_view_make(view.v_string + offset, limit - offset));
+		} else {
+			safe_string_set_error(SAFE_STRING_ERROR_INVALID_ARG);
+			return(_safe_string_view_make(SAFE_STRING_INVALID, SAFE_STRING_EMPTY));
+		}
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(_safe_string_view_make(SAFE_STRING_INVALID, SAFE_STRING_EMPTY));
+	}
+}
+
+/*!
+ * @brief Creates a string holding a copy of the characters a view refers to
+ * @param view source view
+ * @return The newly created string, or SAFE_STRING_INVALID if there was an error
+ * @note Sets the error variable indicating success or failure
+ */
+s_string_t safe_string_view_string(s_string_view_t view)
+{
+	if(safe_string_view_valid(view)) {
+		s_string_t retn = _safe_string_allocate(view.v_length);
+
+		if(retn) {
+			memcpy(retn->s_string, view.v_string, view.v_length);
+			_safe_string_stats_copy(view.v_length);
+		}
+
+		return(retn); /* use the error code from _safe_string_allocate */
+	} else {
+		safe_string_set_error(SAFE_STRING_ERROR_NULL_POINTER);
+		return(SAFE_STRING_INVALID);
+	}
+}